@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <lib/arg_parser/arg_parser.hpp>
+#include <lib/arg_parser/profile/allocation.hpp>
+#include <lib/arg_parser/profile/allocation_hook.hpp>
+#include <lib/labwork_adapter/ArgParser.hpp>
+
+namespace {
+
+// allocations of one warm parse by phase, then parse rate of the re-parse loop
+template<typename ParseType>
+void Measure(std::string_view name, std::size_t parses_count, ParseType&& parse) {
+  if (!parse()) {
+    std::cerr << name << ": parse fail" << std::endl;
+    return;
+  }
+
+  argument_parser::allocation::Recorder recorder;
+  parse();
+  auto report = recorder.Get();
+
+  auto begin = std::chrono::steady_clock::now();
+  for (std::size_t ind = 0; ind < parses_count; ++ind) {
+    parse();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+  std::cout << name << ": " << parses_count / elapsed.count() / 1e3 << " K parses/s\n"
+    << "   per parse " << report << std::endl;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::size_t args_count = argc > 1 ? std::stoul(argv[1]) : 64;
+  std::size_t parses_count = argc > 2 ? std::stoul(argv[2]) : 10000;
+
+  std::vector<std::string> names;
+  std::vector<std::string> options_argv;
+  for (std::size_t ind = 0; ind < args_count; ++ind) {
+    names.push_back("option-" + std::to_string(ind));
+    options_argv.push_back("--" + names.back() + "=" + std::to_string(ind));
+  }
+
+  argument_parser::ArgParser options_parser;
+  for (auto&& name : names) {
+    argument_parser::Argument arg(name);
+    arg.SetStore(new argument_parser::Store<int>{});
+    options_parser.registrate(std::move(arg));
+  }
+  Measure("options \"--option-N=N\"", parses_count, [&]() { return options_parser.parse(options_argv); });
+
+  std::vector<std::string> values_argv;
+  for (std::size_t ind = 0; ind < args_count * 16; ++ind) {
+    values_argv.push_back(std::to_string(ind));
+  }
+  argument_parser::ArgParser values_parser;
+  argument_parser::Argument values("values");
+  values.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<int>>{}).Positional();
+  values_parser.registrate(std::move(values));
+  Measure("positional int list", parses_count / 16, [&]() { return values_parser.parse(values_argv); });
+
+  options_argv.push_back("--unknown");
+  Measure("unknown option (error)", parses_count, [&]() {
+    return !options_parser.parse(options_argv);
+  });
+
+  ArgumentParser::ArgParserLabwork labwork("bench");
+  labwork.AddIntArgument('c', "count");
+  labwork.AddStringArgument('n', "name");
+  labwork.AddFlag('v', "verbose");
+  labwork.AddIntArgument("values").MultiValue<int>(1).Positional();
+  std::string command_line = "bench";
+  for (std::size_t ind = 0; ind < args_count; ++ind) {
+    command_line += " " + std::to_string(ind);
+  }
+  command_line += " --count 3 --name 'big worker' -v";
+  Measure("labwork command line", parses_count, [&]() { return labwork.ParseCommandLine(command_line); });
+
+  return 0;
+};
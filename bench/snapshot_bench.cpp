@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <lib/arg_parser/arg_parser.hpp>
+#include <lib/arg_parser/snapshot/snapshot.hpp>
+
+namespace {
+
+constexpr std::size_t kReadArgsCount = 4;
+
+template<typename ReadType>
+void Measure(std::string_view name, std::size_t threads_count, std::size_t reads_count, ReadType&& read) {
+  std::vector<long long> sums(threads_count);
+  auto begin = std::chrono::steady_clock::now();
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t thread_ind = 0; thread_ind < threads_count; ++thread_ind) {
+      threads.emplace_back([&read, &sums, thread_ind, reads_count]() {
+        long long sum = 0;
+        for (std::size_t ind = 0; ind < reads_count; ++ind) {
+          sum += read(ind % kReadArgsCount);
+        }
+        sums[thread_ind] = sum;
+      });
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+  long long sum = 0;
+  for (auto thread_sum : sums) {
+    sum += thread_sum;
+  }
+  std::cout << name << ": " << threads_count * reads_count / elapsed.count() / 1e6 << " M reads/s"
+    << " (checksum " << sum << ")" << std::endl;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::size_t args_count = argc > 1 ? std::stoul(argv[1]) : 64;
+  std::size_t threads_count = argc > 2 ? std::stoul(argv[2]) : std::max(4u, std::thread::hardware_concurrency());
+  std::size_t reads_count = argc > 3 ? std::stoul(argv[3]) : 2000000;
+
+  // options read by workers are the last registrated, as in a large schema
+  std::vector<std::string> names;
+  std::vector<std::string> argv_cont;
+  for (std::size_t ind = 0; ind < args_count; ++ind) {
+    names.push_back("option-" + std::to_string(ind));
+    argv_cont.push_back("--" + names.back() + "=" + std::to_string(ind));
+  }
+
+  argument_parser::ArgParser parser;
+  for (auto&& name : names) {
+    argument_parser::Argument arg(name);
+    arg.SetStore(new argument_parser::Store<int>{});
+    parser.registrate(std::move(arg));
+  }
+  if (!parser.parse(argv_cont)) {
+    std::cerr << "parse fail" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string_view> read_names;
+  std::vector<argument_parser::ArgHandle<int>> handles;
+  for (std::size_t ind = 0; ind < kReadArgsCount; ++ind) {
+    read_names.push_back(names[args_count - 1 - ind]);
+    handles.push_back(parser.MakeHandle<int>(args_count - 1 - ind));
+  }
+
+  // GetValue is not thread safe, so concurrent readers share a lock
+  std::mutex parser_mutex;
+  Measure("GetValue by name under mutex", threads_count, reads_count / 16, [&](std::size_t ind) {
+    std::lock_guard lock(parser_mutex);
+    return parser.GetValue<int>(read_names[ind]);
+  });
+
+  parser.PublishSnapshot();
+  Measure("ReadSnapshot (rcu)", threads_count, reads_count, [&](std::size_t ind) {
+    return parser.ReadSnapshot()->GetValue(handles[ind]);
+  });
+
+  argument_parser::SetGlobalSnapshot(parser.Freeze());
+  Measure("GetGlobalSnapshot", threads_count, reads_count, [&](std::size_t ind) {
+    return argument_parser::GetGlobalSnapshot().GetValue(handles[ind]);
+  });
+
+  return 0;
+};
@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <lib/arg_parser/tokenizer/tokenizer.hpp>
+
+namespace {
+
+std::string MakeCommandLine(std::size_t words_count) {
+  std::string command_line = "app";
+  for (std::size_t ind = 0; ind < words_count; ++ind) {
+    switch (ind % 4) {
+      case 0: command_line += " --input=/var/data/part_" + std::to_string(ind) + ".bin"; break;
+      case 1: command_line += " -v"; break;
+      case 2: command_line += " --threads " + std::to_string(ind % 64); break;
+      case 3: command_line += " " + std::to_string(ind * 7919); break;
+    }
+  }
+  return command_line;
+};
+
+template<typename RunType>
+void Measure(std::string_view name, std::size_t bytes, std::size_t iterations, RunType&& run) {
+  std::size_t tokens_count = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (std::size_t ind = 0; ind < iterations; ++ind) {
+    tokens_count += run();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+  std::cout << name << ": " << bytes * iterations / elapsed.count() / (1 << 20) << " MiB/s, "
+    << tokens_count / iterations << " tokens" << std::endl;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::size_t words_count = argc > 1 ? std::stoul(argv[1]) : 100000;
+  std::size_t iterations = argc > 2 ? std::stoul(argv[2]) : 20;
+  std::string command_line = MakeCommandLine(words_count);
+
+  Measure("istringstream", command_line.size(), iterations, [&command_line]() {
+    std::istringstream iss(command_line);
+    std::vector<std::string> words{std::istream_iterator<std::string>(iss), std::istream_iterator<std::string>()};
+    return words.size();
+  });
+
+  argument_parser::TokenizerDevice tokenizer;
+  Measure("TokenizerDevice", command_line.size(), iterations, [&command_line, &tokenizer]() {
+    tokenizer.Run(command_line);
+    return tokenizer.GetTokens().size();
+  });
+
+  return 0;
+};
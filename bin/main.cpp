@@ -1,4 +1,6 @@
 #include "argument.hpp"
+#include <charconv>
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <string_view>
@@ -69,6 +71,27 @@ int main(int argc, char** argv) {
     arg
   );
 
+  // "prog complete <cursor> <line>" prints candidates, "prog completion bash|zsh" prints script
+  if (argc > 1 && std::string_view(argv[1]) == "completion") {
+    auto shell = argc > 2 && std::string_view(argv[2]) == "zsh" ?
+      argument_parser::Shell::ZSH : argument_parser::Shell::BASH;
+    std::cout << argument_parser::MakeCompletionScript(shell, argv[0]);
+    return 0;
+  }
+  if (argc > 3 && std::string_view(argv[1]) == "complete") {
+    std::string_view cursor_arg(argv[2]);
+    std::size_t cursor = 0;
+    auto [end, error] = std::from_chars(cursor_arg.data(), cursor_arg.data() + cursor_arg.size(), cursor);
+    if (error != std::errc() || end != cursor_arg.data() + cursor_arg.size()) {
+      std::cerr << "complete: cursor is not a number: " << cursor_arg << std::endl;
+      return 1;
+    }
+    for (auto&& candidate : parser_device.CompleteLine(argv[3], cursor)) {
+      std::cout << candidate << '\n';
+    }
+    return 0;
+  }
+
   if (parser_device.parse(argv_test))
     std::cout << "main:   PARSING SUCCESSFULLY" << std::endl;
   else 
@@ -9,10 +9,26 @@
 
 namespace argument_parser {
 
-bool ArgParser::parse(std::vector<std::string_view>& argv) {
-  LexerDevice lexer;
+bool ArgParser::parse_lexemes(LexerDevice& lexer) {
+  pass_through_ = lexer.MovePassThrough(pass_through_cont_);
+  unknown_cont_ = lexer.GetUnknown();
+
+  auto[lexemes_cont, positional_lexemes_cont] = lexer.GetData();
+
+  if (!environment_.Empty())
+    environment_.Scan(environment_source_ ? environment_source_ : GetProcessEnvironment());
+
+  ParserDevice parser(parallel_threshold_, generation_, &environment_, config_.Empty() ? nullptr : &config_);
   try {
-    lexer.Run(argv, args_);
+    if (!config_.Empty() && !is_config_actual_) {
+      config_.Resolve(get_full_names(), args_.size(), is_strict_);
+      is_config_actual_ = true;
+    }
+    applied_config_hashes_.resize(config_.Empty() ? 0 : args_.size());
+    for (std::size_t slot = 0; slot < applied_config_hashes_.size(); ++slot) {
+      applied_config_hashes_[slot] = config_.GetHash(slot);
+    }
+    parser.Run(args_, validator_, positional_lexemes_cont, lexemes_cont);
   } catch (std::runtime_error& ex){
 #ifdef PARSER_VERBOSE
     std::cerr << ex.what() << std::endl;
@@ -20,53 +36,446 @@ bool ArgParser::parse(std::vector<std::string_view>& argv) {
     return false;
   }
 
-  auto[lexemes_cont, positional_lexemes_cont] = lexer.GetData();
+  return true;
+};
+
+std::size_t ArgParser::registrate_slot(Argument&& arg) {
+  return registrate_single(std::move(arg));
+};
 
-  ParserDevice parser;
+bool ArgParser::LoadConfig(const std::string& path) {
+  is_config_actual_ = false;
+  config_path_ = path;
   try {
-    parser.Run(args_, positional_lexemes_cont, lexemes_cont);
+    config_.Map(path);
   } catch (std::runtime_error& ex){
 #ifdef PARSER_VERBOSE
     std::cerr << ex.what() << std::endl;
 #endif
+    // entries before the malformed line are not applied
+    config_.Clear();
     return false;
   }
+  return true;
+};
 
+bool ArgParser::SetConfig(std::string_view text) {
+  is_config_actual_ = false;
+  config_path_.clear();
+  try {
+    config_.Run(text);
+  } catch (std::runtime_error& ex){
+#ifdef PARSER_VERBOSE
+    std::cerr << ex.what() << std::endl;
+#endif
+    // entries before the malformed line are not applied
+    config_.Clear();
+    return false;
+  }
   return true;
 };
 
-void ArgParser::ClearArguments() {
-  args_.clear();
+void ArgParser::ClearConfig() {
+  config_.Clear();
+  is_config_actual_ = false;
+  config_path_.clear();
 };
 
-std::string ArgParser::GetDescriptions() {
-  std::string full_description;
-  full_description.reserve((
-      std::strlen("   <--") +
-      std::strlen(">, <-") +
-      std::strlen(">  ::  [") +
-      std::strlen("]  ||  ") +
-      10
-    ) * args_.size()
-  );
+std::unique_ptr<const ParseSnapshot> ArgParser::make_snapshot() {
+  std::vector<ParseSnapshot::Entry> entries;
+  entries.reserve(args_.size());
+  for (auto&& arg : args_) {
+    arg.Sync(generation_);
+    entries.push_back({arg.CloneStore(), arg.IsMultivalue()});
+  }
+  return std::make_unique<const ParseSnapshot>(std::move(entries), ++snapshot_version_);
+};
+
+std::shared_ptr<const ParseSnapshot> ArgParser::Freeze() {
+  return make_snapshot();
+};
+
+void ArgParser::PublishSnapshot() {
+  snapshot_.Publish(make_snapshot());
+};
+
+bool ArgParser::Reload() {
+  reloaded_cont_.clear();
+  if (config_path_.empty())
+    return false;
+
+  // changed arguments are converted into copies of their stores, so fail does not touch them
+  ConfigFile config;
+  std::vector<std::pair<std::size_t, std::unique_ptr<BaseStore>>> replaced_cont;
+  try {
+    config.Map(config_path_);
+    config.Resolve(get_full_names(), args_.size(), is_strict_);
+
+    for (std::size_t slot = 0; slot < args_.size(); ++slot) {
+      auto& arg = args_[slot];
+      arg.Sync(generation_);
+      if (arg.GetSource() == Argument::COMMAND_LINE || arg.GetSource() == Argument::ENVIRONMENT)
+        continue;
+
+      auto values = config.GetValues(slot);
+      auto applied_hash = slot < applied_config_hashes_.size() ? applied_config_hashes_[slot] : 0;
+      if (config.GetHash(slot) == applied_hash)
+        continue;
+
+      // bound user variable is written only when the whole reload is accepted
+      auto store = arg.CloneStore();
+#if LABA4
+      store->unbind();
+#endif
+      store->reset_data();
+      if (!store->values_to_data(values)) {
+        allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+        std::string error_message = "reload fail, cannot convert arg\n   from config file to argument: ";
+        error_message += arg.GetFullName();
+        throw std::runtime_error(error_message);
+      }
+      replaced_cont.emplace_back(slot, std::move(store));
+    }
+  } catch (std::runtime_error& ex){
+#ifdef PARSER_VERBOSE
+    std::cerr << ex.what() << std::endl;
+#endif
+    return false;
+  }
+
+  std::vector<Argument::ValueSource> old_sources;
+  std::vector<BaseStore*> new_stores;
+  old_sources.reserve(replaced_cont.size());
+  new_stores.reserve(replaced_cont.size());
+  for (auto&& [slot, store] : replaced_cont) {
+    old_sources.push_back(args_[slot].GetSource());
+    new_stores.push_back(store.get());
+    auto source = config.GetValues(slot).empty() ? Argument::DEFAULT : Argument::CONFIG;
+    store = args_[slot].ExchangeStore(std::move(store), source);
+  }
+
+  try {
+    validator_.Begin();
+    for (std::size_t slot = 0; slot < args_.size(); ++slot) {
+      validator_.Mark(slot, args_[slot].GetStatus());
+    }
+    validator_.Run(args_);
+  } catch (std::runtime_error& ex){
+#ifdef PARSER_VERBOSE
+    std::cerr << ex.what() << std::endl;
+#endif
+    for (std::size_t ind = 0; ind < replaced_cont.size(); ++ind) {
+      auto& [slot, store] = replaced_cont[ind];
+      args_[slot].ExchangeStore(std::move(store), old_sources[ind]);
+    }
+    return false;
+  }
+
+#if LABA4
+  for (std::size_t ind = 0; ind < replaced_cont.size(); ++ind) {
+    new_stores[ind]->bind_as(*replaced_cont[ind].second);
+  }
+#endif
+
+  config_ = std::move(config);
+  is_config_actual_ = true;
+  applied_config_hashes_.resize(args_.size());
+  for (std::size_t slot = 0; slot < args_.size(); ++slot) {
+    applied_config_hashes_[slot] = config_.GetHash(slot);
+  }
+
+  std::vector<ParseSnapshot::Entry> entries;
+  if (auto snapshot = snapshot_.Read(); snapshot && snapshot->GetEntries().size() == args_.size())
+    entries = snapshot->GetEntries();
+  if (entries.empty() && !args_.empty()) {
+    PublishSnapshot();
+  } else {
+    for (auto&& [slot, store] : replaced_cont) {
+      entries[slot] = {args_[slot].CloneStore(), args_[slot].IsMultivalue()};
+    }
+    snapshot_.Publish(std::make_unique<const ParseSnapshot>(std::move(entries), ++snapshot_version_));
+  }
+
+  for (auto&& [slot, store] : replaced_cont) {
+    reloaded_cont_.push_back(slot);
+  }
+  return true;
+};
+
+void ArgParser::AddSubcommand(std::string_view name, SubcommandFactory factory) {
+  subcommand_factories_.emplace_back(name, std::move(factory));
+};
+
+ArgParser* ArgParser::GetSubcommandParser() {
+  if (subcommand_name_.empty())
+    return nullptr;
+  return subcommand_parsers_.at(subcommand_name_).get();
+};
+
+bool ArgParser::parse_subcommand() {
+  std::span<const std::string_view> argv = subcommand_argv_cont_;
+  subcommand_name_ = {};
+
+  auto subcommand_ind = find_subcommand(argv);
+  if (subcommand_ind == argv.size())
+    return parse_options(argv);
+
+  std::string_view name = argv[subcommand_ind];
+  auto factory_itr = subcommand_factories_.find(name);
+  if (factory_itr == subcommand_factories_.end()) {
+#ifdef PARSER_VERBOSE
+    std::cerr << "parse fail, unknown subcommand:\n   \"" << name << "\"" << std::endl;
+#endif
+    parse_options(argv.first(subcommand_ind));
+    parse_status_ = ParseStatus::FAILED;
+    return false;
+  }
+
+  // the name is taken from the factory, argv may be gone before the next parse
+  subcommand_name_ = factory_itr->first;
+  auto& subcommand_parser = get_subcommand_parser(factory_itr->first, factory_itr->second);
+
+  bool is_parse = parse_options(argv.first(subcommand_ind));
+  if (parse_status_ == ParseStatus::HELP_REQUESTED)
+    return true;
+  if (!subcommand_parser.parse(argv.subspan(subcommand_ind + 1)) || !is_parse) {
+    parse_status_ = ParseStatus::FAILED;
+    return false;
+  }
+  return true;
+};
+
+ArgParser& ArgParser::get_subcommand_parser(std::string_view name, const SubcommandFactory& factory) {
+  auto parser_itr = subcommand_parsers_.find(name);
+  if (parser_itr == subcommand_parsers_.end()) {
+    auto parser = std::make_unique<ArgParser>();
+    parser->SetStrict(is_strict_);
+    parser->SetAbbreviation(is_abbreviation_);
+    parser->SetParallelThreshold(parallel_threshold_);
+    parser->SetEnvironmentSource(environment_source_);
+    factory(*parser);
+    subcommand_parsers_.emplace_back(name, std::move(parser));
+    parser_itr = subcommand_parsers_.find(name);
+  }
+  return *parser_itr->second;
+};
+
+std::size_t ArgParser::find_subcommand(std::span<const std::string_view> argv) {
+  // values are taken by the rules of the lexer; unknown options take them as in non strict
+  // mode, strict parse of the options reports them anyway
+  LexerDevice lexer(get_full_names(), false, generation_, is_abbreviation_);
+  try {
+    return lexer.FindFirstPositional(argv, args_.begin(), args_.end());
+  } catch (std::runtime_error& ex){
+#ifdef PARSER_VERBOSE
+    std::cerr << ex.what() << std::endl;
+#endif
+    // ambiguous name is reported by the parse of the whole argv
+    return argv.size();
+  }
+};
 
+void ArgParser::Reset() {
+  ++generation_;
+  pass_through_ = {};
+  unknown_cont_.clear();
+};
+
+const NameTrie& ArgParser::get_full_names() {
+  if (!is_full_names_actual_) {
+    std::uint64_t schema_hash = schema_cache_path_.empty() ? 0 : GetSchemaHash();
+    is_schema_cached_ = !schema_cache_path_.empty() &&
+      schema_cache_.Load(schema_cache_path_, schema_hash, args_.size(), full_names_);
+
+    if (!is_schema_cached_) {
+      std::vector<NameTrie::NameType> names;
+      names.reserve(args_.size());
+      for (std::size_t slot = 0; slot < args_.size(); ++slot) {
+        if (!args_[slot].GetFullName().empty())
+          names.emplace_back(args_[slot].GetFullName(), static_cast<NameTrie::SlotType>(slot));
+      }
+      full_names_.Build(std::move(names));
+      if (!schema_cache_path_.empty())
+        SchemaCache::Store(schema_cache_path_, schema_hash, args_.size(), full_names_);
+    }
+
+    std::vector<std::string_view> environment_names;
+    for (auto&& arg : args_) {
+      if (!arg.GetEnvironment().empty())
+        environment_names.push_back(arg.GetEnvironment());
+    }
+    environment_.SetNames(environment_names);
+    is_full_names_actual_ = true;
+    is_config_actual_ = false;
+  }
+  return full_names_;
+};
+
+void ArgParser::SetSchemaCache(std::string path) {
+  schema_cache_path_ = std::move(path);
+  is_full_names_actual_ = false;
+};
+
+std::uint64_t ArgParser::GetSchemaHash() const {
+  SchemaHash hash;
+  hash.Add(args_.size());
   for (auto&& arg : args_) {
-    full_description += "   <--";
-    full_description += {arg.GetFullName().begin(), arg.GetFullName().end()};
-    full_description += ">, ";
-    if (arg.GetShortName() != "") {
-      full_description += "<-";
-      full_description += {arg.GetShortName().begin(), arg.GetShortName().end()};
-      full_description += ">  ::  ";
+    hash.Add(arg.GetFullName());
+    hash.Add(arg.GetShortName());
+    hash.Add(arg.IsPositional() << 2 | arg.IsMultivalue() << 1 | arg.IsValueless());
+  }
+  return hash.Get();
+};
+
+const std::vector<char>& ArgParser::SerializeResult() {
+  result_writer_.Begin(GetSchemaHash(), args_.size());
+  for (std::size_t slot = 0; slot < args_.size(); ++slot) {
+    args_[slot].Sync(generation_);
+    result_writer_.Add(slot, args_[slot]);
+  }
+  return result_writer_.End();
+};
+
+std::vector<std::string_view> ArgParser::Complete(std::string_view prefix) {
+  std::vector<NameTrie::SlotType> slots;
+  get_full_names().Complete(prefix, slots);
+
+  std::vector<std::string_view> names;
+  names.reserve(slots.size());
+  for (auto slot : slots) {
+    names.push_back(args_[slot].GetFullName());
+  }
+  return names;
+};
+
+std::vector<std::string> ArgParser::Complete(std::span<const std::string_view> words) {
+  std::vector<std::string> candidates;
+  if (words.empty())
+    return candidates;
+  std::string_view word = words.back();
+  auto previous = words.first(words.size() - 1);
+
+  // words after subcommand are completed by its parser
+  if (!subcommand_factories_.empty()) {
+    auto subcommand_ind = find_subcommand(previous);
+    if (subcommand_ind != previous.size()) {
+      auto factory_itr = subcommand_factories_.find(previous[subcommand_ind]);
+      if (factory_itr == subcommand_factories_.end())
+        return candidates;
+      return get_subcommand_parser(factory_itr->first, factory_itr->second).Complete(
+        words.subspan(subcommand_ind + 1));
+    }
+  }
+
+  std::vector<std::string_view> choices;
+  auto add_choices = [this, &choices, &candidates](std::size_t slot, std::string_view prefix,
+    std::string_view value_prefix) {
+    choices.clear();
+    args_[slot].GetChoices(choices);
+    for (auto choice : choices) {
+      if (choice.starts_with(value_prefix))
+        candidates.emplace_back(prefix).append(choice);
+    }
+  };
+
+  if (word.starts_with("--")) {
+    auto separator_pos = word.find('=');
+    if (separator_pos != word.npos) {
+      auto slot = find_option_slot(word.substr(0, separator_pos));
+      if (slot < args_.size())
+        add_choices(slot, word.substr(0, separator_pos + 1), word.substr(separator_pos + 1));
+      return candidates;
     }
-    full_description += "[";
-    full_description += arg.GetStrStoreType();
-    full_description += "]  ||  ";
-    full_description += {arg.GetDescription().begin(), arg.GetDescription().end()};
-    full_description += "\n";
+    for (auto name : Complete(word.substr(2))) {
+      candidates.emplace_back("--").append(name);
+    }
+    return candidates;
+  }
+
+  if (word.starts_with('-') && word.size() <= 2) {
+    for (auto&& arg : args_) {
+      if (!arg.GetShortName().empty() && arg.GetShortName().starts_with(word.substr(1)))
+        candidates.emplace_back("-").append(arg.GetShortName());
+    }
+    if (word == "-") {
+      for (auto name : Complete(std::string_view{})) {
+        candidates.emplace_back("--").append(name);
+      }
+    }
+    return candidates;
+  }
+
+  // value of the last option, multivalue one takes all words after it
+  for (std::size_t ind = previous.size(); ind > 0; --ind) {
+    std::string_view token = previous[ind - 1];
+    if (!token.starts_with('-') || token == "-")
+      continue;
+    auto slot = token.find('=') == token.npos ? find_option_slot(token) : args_.size();
+    if (slot < args_.size() && !args_[slot].IsValueless() &&
+      (ind == previous.size() || args_[slot].IsMultivalue())) {
+      add_choices(slot, "", word);
+      return candidates;
+    }
+    break;
+  }
+
+  for (auto&& [name, factory] : subcommand_factories_) {
+    if (name.starts_with(word))
+      candidates.emplace_back(name);
+  }
+  for (std::size_t slot = 0; slot < args_.size(); ++slot) {
+    if (args_[slot].IsPositional())
+      add_choices(slot, "", word);
   }
+  return candidates;
+};
+
+std::vector<std::string> ArgParser::CompleteLine(std::string_view line, std::size_t cursor) {
+  TokenizerDevice tokenizer;
+  std::vector<std::string_view> words;
+  if (!SplitCompletionLine(line, cursor, tokenizer, words))
+    return {};
+  return Complete(words);
+};
+
+std::size_t ArgParser::find_option_slot(std::string_view token) {
+  if (token.starts_with("--")) {
+    auto& full_names = get_full_names();
+    auto slot = is_abbreviation_ ? full_names.FindPrefix(token.substr(2)) : full_names.Find(token.substr(2));
+    return slot == NameTrie::kNotFound || slot == NameTrie::kAmbiguous ? args_.size() : slot;
+  }
+  for (std::size_t slot = 0; slot < args_.size(); ++slot) {
+    if (!args_[slot].GetShortName().empty() && args_[slot].GetShortName() == token.substr(1))
+      return slot;
+  }
+  return args_.size();
+};
 
-  return full_description;
+void ArgParser::ClearArguments() {
+  args_.clear();
+  validator_.Clear();
+  is_full_names_actual_ = false;
+  is_help_actual_ = false;
+};
+
+const HelpLayout& ArgParser::get_help() {
+  if (!is_help_actual_) {
+    help_.Build(args_, help_width_);
+    is_help_actual_ = true;
+  }
+  return help_;
+};
+
+void ArgParser::WriteHelp(std::ostream& stream) {
+  get_help().Write(stream);
+};
+
+std::size_t ArgParser::WriteHelp(std::span<char> buffer) {
+  return get_help().Write(buffer);
+};
+
+std::string ArgParser::GetDescriptions() {
+  return std::string(get_help().GetText());
 };
 
 } // argument_parser
\ No newline at end of file
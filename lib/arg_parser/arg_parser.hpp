@@ -1,37 +1,267 @@
 #ifndef _ARG_PARSER_HPP_
 #define _ARG_PARSER_HPP_
 
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 #include <string_view>
 
 #include <lib/arg_parser/argument/argument.hpp>
+#include <lib/arg_parser/argument/handle.hpp>
+#include <lib/arg_parser/completion/completion.hpp>
+#include <lib/arg_parser/config/config.hpp>
+#include <lib/arg_parser/environment/environment.hpp>
+#include <lib/arg_parser/help/help.hpp>
+#include <lib/arg_parser/lexer/lexer.hpp>
+#include <lib/arg_parser/result/result.hpp>
+#include <lib/arg_parser/schema/schema.hpp>
+#include <lib/arg_parser/snapshot/rcu.hpp>
+#include <lib/arg_parser/snapshot/snapshot.hpp>
+#include <lib/arg_parser/store/flat_map.hpp>
+#include <lib/arg_parser/trie/trie.hpp>
+#include <lib/arg_parser/validator/validator.hpp>
+
+#ifdef PARSER_VERBOSE
+#include <iostream>
+#endif
 
 namespace argument_parser {
 
+enum class ParseStatus { FAILED, PARSED, HELP_REQUESTED };
+
 class ArgParser {
+ public:
+  // registrates arguments of subcommand into its own parser
+  using SubcommandFactory = std::function<void(ArgParser&)>;
+
  public:
   template<typename... ArgumentType>
   void registrate(ArgumentType&&... args);
+  // slot of the argument, already registrated one with the same names keeps its slot;
+  // kNoSlot if that one has other store type, so a handle never reads a store of other type
+  static constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
+  std::size_t registrate_slot(Argument&& arg);
+
+  // tokens are read once and straight into the lexer, argv must outlive parse results
+  template<IsArgvRange RangeType>
+  bool parse(RangeType&& argv);
+  // the first positional selects subcommand, only its parser is built by factory, once;
+  // tokens before it are parsed by this parser, the rest by the subcommand one
+  void AddSubcommand(std::string_view name, SubcommandFactory factory);
+  inline std::string_view GetSubcommand() const { return subcommand_name_; };
+  // HELP_REQUESTED parse is successful, but only the help option has value:
+  // argv after it is not read, nothing is converted and required arguments are not checked
+  inline ParseStatus GetParseStatus() const { return parse_status_; };
+  // flag argument, its names are searched before lexing; kNoHelp turns the search off
+  static constexpr std::size_t kNoHelp = static_cast<std::size_t>(-1);
+  inline void SetHelpSlot(std::size_t slot) { help_slot_ = slot; };
+  // parser of selected subcommand, nullptr if there is no one
+  ArgParser* GetSubcommandParser();
 
-  bool parse(std::vector<std::string_view>& argv);
+  // values of the last parse are read as defaults until the next parse, O(1)
+  void Reset();
   void ClearArguments();
 
+  // in non strict mode not registrated options are collected instead of parse fail
+  inline void SetStrict(bool is_strict) {
+    is_strict_ = is_strict;
+    is_config_actual_ = false;
+  };
+  // unique prefix of full name is accepted, "--verb" for "--verbose"; ambiguous prefix fails parse
+  inline void SetAbbreviation(bool is_abbreviation) { is_abbreviation_ = is_abbreviation; };
+  // full names starting with prefix in lexicographic order
+  std::vector<std::string_view> Complete(std::string_view prefix);
+  // candidates for the last of words, which is under cursor: options, choice values and
+  // subcommands; names are found by the trie, nothing is parsed or converted
+  std::vector<std::string> Complete(std::span<const std::string_view> words);
+  // partial command line with program name, as COMP_LINE and COMP_POINT of bash
+  std::vector<std::string> CompleteLine(std::string_view line, std::size_t cursor);
+
+  // built schema is mapped from the file while it matches registrated arguments,
+  // otherwise it is built and the file is rewritten
+  void SetSchemaCache(std::string path);
+  // schema of the last build was taken from the cache file
+  inline bool IsSchemaCached() const { return is_schema_cached_; };
+  // hash of registrated arguments, caches and results of other schema are rejected
+  std::uint64_t GetSchemaHash() const;
+
+  // result of the last parse in one buffer, e.g. for child processes; it is read in place
+  // by ResultView loaded with the same schema hash. the buffer is reused by the next call
+  const std::vector<char>& SerializeResult();
+
+  // variables of Argument::SetEnvironment are read from it once per parse, nullptr is environ
+  // of the process; precedence is command line, then environment, then default
+  inline void SetEnvironmentSource(char** environment) { environment_source_ = environment; };
+
+  // "key = value" file under the command line and environment, mapped until the next load;
+  // keys are full names, unknown keys fail the parse in strict mode
+  bool LoadConfig(const std::string& path);
+  // text of config must outlive parse results
+  bool SetConfig(std::string_view text);
+  void ClearConfig();
+
+  // parse result is frozen into immutable snapshot, read from any thread without locks;
+  // pass it to workers or set it by SetGlobalSnapshot
+  std::shared_ptr<const ParseSnapshot> Freeze();
+  // frozen snapshot is published for ReadSnapshot, readers of other threads see it whole
+  void PublishSnapshot();
+  // snapshot is valid while the guard is alive, the guard is empty before the first publish
+  inline RcuCell<ParseSnapshot>::ReadGuard ReadSnapshot() const { return snapshot_.Read(); };
+  // config file is read again, only arguments with changed config values are converted and
+  // the new snapshot shares the rest with the previous one; on fail nothing is changed,
+  // also variables of SetPtrStore, which are written only when the reload is accepted.
+  // string_view values of config point into the replaced mapping, use std::string for them
+  bool Reload();
+  // slots of arguments changed by the last Reload
+  inline const std::vector<std::size_t>& GetReloaded() const { return reloaded_cont_; };
+
+  // positional multivalue lists not shorter than threshold are converted in parallel
+  inline void SetParallelThreshold(std::size_t threshold) { parallel_threshold_ = threshold; };
+
   template<typename ValueType>
   auto GetValue(std::string_view arg_name);
 
   template<typename ValueType>
   auto GetMultiValue(std::string_view arg_name);
 
+  // handle must be made by MakeHandle of this parser
+  template<typename ValueType>
+  inline const ValueType& GetValue(ArgHandle<ValueType> handle) const {
+    const auto& arg = args_[handle.GetSlot()];
+    if (!arg.IsCurrent(generation_))
+      return arg.template GetDefaultRef<ValueType>();
+    return arg.template GetDataRef<ValueType>();
+  };
+
+  // invalid handle for unknown slot or other value type
+  template<typename ValueType>
+  ArgHandle<ValueType> MakeHandle(std::size_t slot) const;
+
+  // help is laid out once after registration changes and then only copied out
+  void WriteHelp(std::ostream& stream);
+  // size of the whole help, nothing is written into smaller buffer
+  std::size_t WriteHelp(std::span<char> buffer);
   std::string GetDescriptions();
+  inline void SetHelpWidth(std::size_t width) {
+    help_width_ = width;
+    is_help_actual_ = false;
+  };
+
+  // tokens after "--" terminator, not lexed and pointed into argv of the last parse
+  inline std::span<const std::string_view> GetPassThrough() const { return pass_through_; };
+  // whole argv tokens of not registrated options in order, filled in non strict mode;
+  // only value glued by "=" goes with the option, "--mode fast" leaves "fast" positional
+  inline const std::vector<std::string_view>& GetUnknown() const { return unknown_cont_; };
 
  private:
   template<typename ArgumentType>
-  void registrate_single(ArgumentType&& arg);
+  std::size_t registrate_single(ArgumentType&& arg);
+  template<IsArgvRange RangeType>
+  bool parse_options(RangeType&& argv);
+  bool parse_lexemes(LexerDevice& lexer);
+  bool parse_subcommand();
+  // built once and kept for the next parses
+  ArgParser& get_subcommand_parser(std::string_view name, const SubcommandFactory& factory);
+  // slot of "--name" or "-n" token, args_.size() for unknown
+  std::size_t find_option_slot(std::string_view token);
+  // index of the first token which is not an option or value of an option
+  std::size_t find_subcommand(std::span<const std::string_view> argv);
+  // trie and environment names are rebuilt once after registration changes
+  const NameTrie& get_full_names();
+  std::unique_ptr<const ParseSnapshot> make_snapshot();
+  const HelpLayout& get_help();
 
  private:
   std::vector<Argument> args_;
+  ValidatorDevice validator_;
+  NameTrie full_names_;
+  bool is_full_names_actual_ = false;
+  bool is_abbreviation_ = false;
+  std::string schema_cache_path_;
+  SchemaCache schema_cache_;
+  bool is_schema_cached_ = false;
+  HelpLayout help_;
+  bool is_help_actual_ = false;
+  std::size_t help_width_ = HelpLayout::kDefaultWidth;
+  EnvironmentIndex environment_;
+  char** environment_source_ = nullptr;
+  ConfigFile config_;
+  // values of config are grouped by slot once after load or registration changes
+  bool is_config_actual_ = false;
+  // hashes of config values given to the stores by the last parse or reload, by slot;
+  // kept apart from is_config_actual_, which is cleared while the values stay
+  std::vector<std::uint64_t> applied_config_hashes_;
+  std::string config_path_;
+
+  RcuCell<ParseSnapshot> snapshot_;
+  std::uint64_t snapshot_version_ = 0;
+  std::vector<std::size_t> reloaded_cont_;
+  ResultWriter result_writer_;
+
+  std::span<const std::string_view> pass_through_;
+  std::vector<std::string_view> pass_through_cont_;
+  std::vector<std::string_view> unknown_cont_;
+  bool is_strict_ = true;
+  std::size_t help_slot_ = kNoHelp;
+  ParseStatus parse_status_ = ParseStatus::FAILED;
+  std::size_t parallel_threshold_ = parallel::kDefaultThreshold;
+  // every parse and reset starts new generation, arguments of older one are stale
+  std::uint64_t generation_ = 0;
+
+  FlatMap<std::string_view, SubcommandFactory> subcommand_factories_;
+  // built subcommand parsers, kept for the next parses
+  FlatMap<std::string_view, std::unique_ptr<ArgParser>> subcommand_parsers_;
+  std::string_view subcommand_name_;
+  std::vector<std::string_view> subcommand_argv_cont_;
+};
+
+template<IsArgvRange RangeType>
+bool ArgParser::parse(RangeType&& argv) {
+  if (subcommand_factories_.empty())
+    return parse_options(std::forward<RangeType>(argv));
+
+  // argv is split by the subcommand, so it is read into views first
+  subcommand_argv_cont_.clear();
+  for (auto&& token : argv) {
+    subcommand_argv_cont_.emplace_back(token);
+  }
+  return parse_subcommand();
+};
+
+template<IsArgvRange RangeType>
+bool ArgParser::parse_options(RangeType&& argv) {
+  ++generation_;
+  LexerDevice lexer(get_full_names(), is_strict_, generation_, is_abbreviation_);
+  if (help_slot_ < args_.size())
+    lexer.SetHelp(args_[help_slot_].GetFullName(), args_[help_slot_].GetShortName());
+  pass_through_ = {};
+  unknown_cont_.clear();
+  parse_status_ = ParseStatus::FAILED;
+  try {
+    lexer.Run(std::forward<RangeType>(argv), args_);
+  } catch (std::runtime_error& ex){
+#ifdef PARSER_VERBOSE
+    std::cerr << ex.what() << std::endl;
+#endif
+    return false;
+  }
+
+  if (lexer.IsHelpRequested()) {
+    args_[help_slot_].Sync(generation_);
+    args_[help_slot_].occur();
+    parse_status_ = ParseStatus::HELP_REQUESTED;
+    return true;
+  }
+  if (!parse_lexemes(lexer))
+    return false;
+  parse_status_ = ParseStatus::PARSED;
+  return true;
 };
 
 template<typename ValueType>
@@ -39,6 +269,7 @@ auto ArgParser::GetValue(std::string_view arg_name) {
   for (auto&& elem : args_) {
     if (elem.GetFullName() == arg_name ||
         elem.GetShortName() == arg_name) {
+      elem.Sync(generation_);
       if (elem.IsMultivalue()) {
         return ValueType{GetMultiValue<std::vector<ValueType>>(arg_name)[0]};
       } else {
@@ -53,8 +284,10 @@ template<typename ValueType>
 auto ArgParser::GetMultiValue(std::string_view arg_name) {
   for (auto&& elem : args_) {
     if (elem.GetFullName() == arg_name ||
-        elem.GetShortName() == arg_name)
+        elem.GetShortName() == arg_name) {
+      elem.Sync(generation_);
       return elem.GetMultiData<ValueType>();
+    }
   }
   return ValueType{};
 };
@@ -71,15 +304,34 @@ void ArgParser::registrate(ArgumentType&&... args) {
 };
 
 template<typename ArgumentType>
-void ArgParser::registrate_single(ArgumentType&& arg) {
-  for (auto&& arg_by_cont : args_) {
-    if (arg_by_cont.GetFullName() == arg.GetFullName() &&
-      arg_by_cont.GetShortName() == arg.GetShortName()) {
-      return;
+std::size_t ArgParser::registrate_single(ArgumentType&& arg) {
+  for (std::size_t slot = 0; slot < args_.size(); ++slot) {
+    if (args_[slot].GetFullName() == arg.GetFullName() &&
+      args_[slot].GetShortName() == arg.GetShortName()) {
+      const BaseStore* slot_store = args_[slot].GetStorePtr();
+      const BaseStore* store = arg.GetStorePtr();
+      if (slot_store && store ? typeid(*slot_store) == typeid(*store) : slot_store == store)
+        return slot;
+#ifdef PARSER_VERBOSE
+      std::cerr << "registrate fail, argument is registrated with other type:\n   \"" <<
+        arg.GetFullName() << "\"" << std::endl;
+#endif
+      return kNoSlot;
     }
   }
-  
+
   args_.push_back(std::move(arg));
+  validator_.Registrate(args_.back());
+  is_full_names_actual_ = false;
+  is_help_actual_ = false;
+  return args_.size() - 1;
+};
+
+template<typename ValueType>
+ArgHandle<ValueType> ArgParser::MakeHandle(std::size_t slot) const {
+  if (slot >= args_.size() || !args_[slot].template IsHolding<ValueType>())
+    return {};
+  return ArgHandle<ValueType>(slot);
 };
 
 } // argument_parser
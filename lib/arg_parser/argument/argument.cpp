@@ -21,6 +21,8 @@ Argument::Argument(std::string_view full_name) :
 Argument::Argument(Argument&& value) :
   full_name_(value.full_name_), short_name_(value.short_name_), description_(value.description_),
   is_multivalue_(value.is_multivalue_), is_positional_(value.is_positional_), is_found_(value.is_found_),
+  base_status_(value.base_status_), source_(value.source_), environment_name_(value.environment_name_),
+  generation_(value.generation_),
   min_val(value.min_val), store_(std::move(value.store_)) {  };
 
 Argument& Argument::operator=(Argument&& value) {
@@ -32,18 +34,86 @@ Argument& Argument::operator=(Argument&& value) {
   description_ = value.description_;
   is_multivalue_ = value.is_multivalue_;
   is_positional_ = value.is_positional_;
+  is_found_ = value.is_found_;
+  base_status_ = value.base_status_;
+  source_ = value.source_;
+  environment_name_ = value.environment_name_;
+  generation_ = value.generation_;
   store_ = std::move(value.store_);
 
   return *this;
 }
 
 bool Argument::convert(std::string_view string_data) {
-  bool covertation_res = store_->string_to_data({string_data.begin(), string_data.end()});
-  if (covertation_res)
+  bool covertation_res = store_->string_to_data(string_data);
+  if (covertation_res) {
     is_found_ = FoundClasses::WAS_INITIALIZE;
+    source_ = ValueSource::COMMAND_LINE;
+  }
+  return covertation_res;
+};
+
+bool Argument::convert_config(std::span<const std::string_view> string_data_cont) {
+  if (!store_->values_to_data(string_data_cont))
+    return false;
+  if (!string_data_cont.empty()) {
+    is_found_ = FoundClasses::WAS_INITIALIZE;
+    source_ = ValueSource::CONFIG;
+  }
+  return true;
+};
+
+std::unique_ptr<BaseStore> Argument::ExchangeStore(std::unique_ptr<BaseStore> store, ValueSource source) {
+  is_found_ = source == ValueSource::DEFAULT ? base_status_ : FoundClasses::WAS_INITIALIZE;
+  source_ = source;
+  store_.swap(store);
+  return store;
+};
+
+bool Argument::convert_environment(std::string_view string_data) {
+  bool covertation_res = store_->string_to_data(string_data);
+  if (covertation_res) {
+    is_found_ = FoundClasses::WAS_INITIALIZE;
+    source_ = ValueSource::ENVIRONMENT;
+  }
   return covertation_res;
 };
 
+std::size_t Argument::convert(std::span<const std::string_view> string_data_cont,
+  std::size_t parallel_threshold) {
+  std::size_t converted_count = store_->strings_to_data(string_data_cont, parallel_threshold);
+  if (converted_count) {
+    is_found_ = FoundClasses::WAS_INITIALIZE;
+    source_ = ValueSource::COMMAND_LINE;
+  }
+  return converted_count;
+};
+
+void Argument::Sync(std::uint64_t generation) {
+  if (generation_ == generation)
+    return;
+
+  // status set by the builder is taken on the first sync, store holds defaults yet
+  if (generation_ == 0) {
+    base_status_ = is_found_;
+  } else {
+    is_found_ = base_status_;
+    source_ = ValueSource::DEFAULT;
+    if (store_)
+      store_->reset_data();
+  }
+  generation_ = generation;
+};
+
+bool Argument::occur() {
+  bool occurrence_res = store_->occurrence_to_data();
+  if (occurrence_res) {
+    is_found_ = FoundClasses::WAS_INITIALIZE;
+    source_ = ValueSource::COMMAND_LINE;
+  }
+  return occurrence_res;
+};
+
 template<>
 Argument& Argument::SetStore<bool>(Store<bool>* store_ptr) {
   if (store_) {
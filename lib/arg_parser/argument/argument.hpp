@@ -1,8 +1,11 @@
 #ifndef _ARGUMENT_HPP_
 #define _ARGUMENT_HPP_
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <string_view>
+#include <vector>
 #include <iostream>
 
 #include <lib/arg_parser/store/store.hpp>
@@ -12,6 +15,9 @@ namespace argument_parser {
 class Argument {
  public:
   enum FoundClasses { NOT_FOUND, WAS_FOUND, WAS_INITIALIZE };
+  // where the value came from, ordered by precedence: command line overrides environment,
+  // environment overrides config file, config file overrides default
+  enum ValueSource { DEFAULT, CONFIG, ENVIRONMENT, COMMAND_LINE };
  public:
   Argument() = default;
   Argument(const Argument& value) = delete;
@@ -25,6 +31,12 @@ class Argument {
 
  public:
   bool convert(std::string_view string_data);
+  std::size_t convert(std::span<const std::string_view> string_data_cont, std::size_t parallel_threshold);
+  bool occur();
+  // value of environment variable, used when the option is not in command line
+  bool convert_environment(std::string_view string_data);
+  // values of config file in order, empty value of flag is its occurrence
+  bool convert_config(std::span<const std::string_view> string_data_cont);
 
   template<typename ValueType>
   auto GetData();
@@ -32,6 +44,25 @@ class Argument {
   template<typename ValueType>
   auto GetMultiData();
 
+  // checked once with RTTI, so handle reads can use GetDataRef
+  template<typename ValueType>
+  bool IsHolding() const;
+
+  // store type is not checked, see IsHolding
+  template<typename ValueType>
+  const ValueType& GetDataRef() const;
+  template<typename ValueType>
+  const ValueType& GetDefaultRef() const;
+
+  // store of the same value type with data of given source, the previous store is returned
+  std::unique_ptr<BaseStore> ExchangeStore(std::unique_ptr<BaseStore> store, ValueSource source);
+  inline std::unique_ptr<BaseStore> CloneStore() const { return store_->clone(); };
+
+  // state of older parse generation is replaced by registrated one on the first touch,
+  // so reset of the whole parser is one increment
+  void Sync(std::uint64_t generation);
+  inline bool IsCurrent(std::uint64_t generation) const { return generation_ == generation; };
+
  public:
   template<typename StoreType>
   Argument& SetStore(Store<StoreType>* store_ptr);
@@ -39,7 +70,14 @@ class Argument {
  public:
   inline bool IsMultivalue() const { return is_multivalue_; };
   inline bool IsPositional() const { return is_positional_; };
-  inline FoundClasses GetStatus() { return is_found_; };
+  inline bool IsValueless() const { return store_ && store_->IsValueless(); };
+  inline FoundClasses GetStatus() const { return is_found_; };
+  inline ValueSource GetSource() const { return source_; };
+  inline std::string_view GetEnvironment() const { return environment_name_; };
+  inline Argument& SetEnvironment(std::string_view environment_name) {
+    environment_name_ = environment_name;
+    return *this;
+  };
 
   inline void WasFound() { is_found_ = FoundClasses::WAS_FOUND; };
   inline void WasInitialize() { is_found_ = FoundClasses::WAS_INITIALIZE; };
@@ -55,6 +93,10 @@ class Argument {
   inline std::string_view GetShortName() const { return short_name_; };
   inline std::string_view GetDescription() const { return description_; };
   inline std::string GetStrStoreType() const { return store_->GetStrType(); };
+  inline void GetChoices(std::vector<std::string_view>& choices) const {
+    if (store_)
+      store_->GetChoices(choices);
+  };
 
   inline const BaseStore* GetStorePtr() const { return store_.get(); };
 
@@ -65,6 +107,10 @@ class Argument {
   bool is_multivalue_ = false;
   bool is_positional_ = false;
   FoundClasses is_found_ = FoundClasses::NOT_FOUND;
+  FoundClasses base_status_ = FoundClasses::NOT_FOUND;
+  ValueSource source_ = ValueSource::DEFAULT;
+  std::string_view environment_name_ = "";
+  std::uint64_t generation_ = 0;
 
   std::unique_ptr<BaseStore> store_ = nullptr;
 #ifdef LABA4
@@ -104,6 +150,33 @@ auto Argument::GetMultiData() {
   return ValueType{};
 };
 
+template<typename ValueType>
+bool Argument::IsHolding() const {
+  if constexpr (IsContainer<ValueType>) {
+    if (is_multivalue_)
+      return dynamic_cast<const MultiValueStore<ValueType>*>(store_.get());
+  }
+  return !is_multivalue_ && dynamic_cast<const Store<ValueType>*>(store_.get());
+};
+
+template<typename ValueType>
+const ValueType& Argument::GetDataRef() const {
+  if constexpr (IsContainer<ValueType>) {
+    if (is_multivalue_)
+      return static_cast<const MultiValueStore<ValueType>&>(*store_).data_;
+  }
+  return static_cast<const Store<ValueType>&>(*store_).data_;
+};
+
+template<typename ValueType>
+const ValueType& Argument::GetDefaultRef() const {
+  if constexpr (IsContainer<ValueType>) {
+    if (is_multivalue_)
+      return static_cast<const MultiValueStore<ValueType>&>(*store_).default_;
+  }
+  return static_cast<const Store<ValueType>&>(*store_).default_;
+};
+
 template<typename StoreType>
 Argument& Argument::SetStore(Store<StoreType>* store_ptr) {
   if (store_) {
@@ -0,0 +1,27 @@
+#ifndef _HANDLE_HPP_
+#define _HANDLE_HPP_
+
+#include <cstddef>
+
+namespace argument_parser {
+
+// typed slot of registrated argument, reads through it skip name lookup and RTTI
+template<typename ValueType>
+class ArgHandle {
+ public:
+  static constexpr std::size_t kInvalidSlot = static_cast<std::size_t>(-1);
+
+ public:
+  ArgHandle() = default;
+  explicit ArgHandle(std::size_t slot) : slot_(slot) {  };
+
+  inline std::size_t GetSlot() const { return slot_; };
+  inline bool IsValid() const { return slot_ != kInvalidSlot; };
+
+ private:
+  std::size_t slot_ = kInvalidSlot;
+};
+
+} // argument_parser
+
+#endif // _HANDLE_HPP_
@@ -0,0 +1,268 @@
+#ifndef _BINDING_HPP_
+#define _BINDING_HPP_
+
+#include <bitset>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <lib/arg_parser/lexer/lexer.hpp>
+#include <lib/arg_parser/store/store.hpp>
+
+#ifdef PARSER_VERBOSE
+#include <iostream>
+#endif
+
+namespace argument_parser {
+
+// option which is parsed straight into StructType::*member, struct initializers are defaults
+template<typename StructType, typename FieldType>
+struct FieldBinding {
+  std::string_view full_name;
+  char short_name = '\0';
+  std::string_view description;
+  FieldType StructType::* member = nullptr;
+  bool is_required = false;
+  bool is_positional = false;
+
+  constexpr FieldBinding Required() const {
+    FieldBinding field = *this;
+    field.is_required = true;
+    return field;
+  };
+
+  constexpr FieldBinding Positional() const {
+    FieldBinding field = *this;
+    field.is_positional = true;
+    return field;
+  };
+};
+
+template<typename StructType, typename FieldType>
+constexpr FieldBinding<StructType, FieldType> Bind(char short_name, std::string_view full_name,
+  FieldType StructType::* member, std::string_view description = "") {
+  return {full_name, short_name, description, member};
+};
+
+template<typename StructType, typename FieldType>
+constexpr FieldBinding<StructType, FieldType> Bind(std::string_view full_name,
+  FieldType StructType::* member, std::string_view description = "") {
+  return Bind('\0', full_name, member, description);
+};
+
+namespace binding {
+
+// bool field is a flag, container field collects every value of the option
+template<typename FieldType>
+constexpr bool kIsFlag = std::is_same_v<FieldType, bool>;
+
+template<typename FieldType>
+constexpr bool kIsList = IsContainer<FieldType> && !std::is_same_v<FieldType, std::string>;
+
+template<typename FieldType>
+bool ConvertField(std::string_view str_data, FieldType& field) {
+  if constexpr (kIsList<FieldType>) {
+    using ValueType = typename FieldType::value_type;
+    auto push_item = [&field](std::string_view item) {
+      ValueType value{};
+      if (!Converter<ValueType>::Convert(item, value))
+        return false;
+      field.push_back(std::move(value));
+      return true;
+    };
+
+    if constexpr (numeric::IsNumber<ValueType>) {
+      return numeric::ForEachItem(str_data, numeric::kListSeparator, push_item);
+    } else {
+      return push_item(str_data);
+    }
+  } else {
+    return Converter<FieldType>::Convert(str_data, field);
+  }
+};
+
+inline void ThrowParseFail(std::string_view reason, std::string_view token) {
+  allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+  std::string error_message = "parse fail, ";
+  error_message += reason;
+  error_message += "\n   \"";
+  error_message += token;
+  error_message += "\"\n";
+  throw std::runtime_error(error_message);
+};
+
+} // binding
+
+// whole options struct described by member pointers; fields are parsed straight into
+// the struct, so there are no stores, no copies and no virtual calls
+//   constexpr auto kBinding = MakeBinding(Bind("sum", &Options::sum), Bind('v', "verbose", &Options::verbose));
+//   Options options; kBinding.Parse(argv, options);
+template<typename StructType, typename... FieldTypes>
+class Binding {
+ public:
+  static constexpr std::size_t kFieldsCount = sizeof...(FieldTypes);
+
+ public:
+  constexpr Binding(FieldBinding<StructType, FieldTypes>... fields) : fields_(fields...) {  };
+
+  // argv without program name, as for ArgParser::parse
+  template<IsArgvRange RangeType>
+  bool Parse(RangeType&& argv, StructType& options) const;
+
+  inline const std::tuple<FieldBinding<StructType, FieldTypes>...>& GetFields() const { return fields_; };
+
+ private:
+  // calls apply(field, ind) for the first field satisfying pred(field, ind), loop is unrolled
+  template<typename PredType, typename ApplyType>
+  bool Visit(PredType&& pred, ApplyType&& apply) const;
+
+  template<typename InItr, typename EndType>
+  void ParseOption(InItr& argv_itr, EndType argv_end, StructType& options,
+    std::bitset<kFieldsCount>& found_fields) const;
+
+  void ParsePositional(std::string_view token, StructType& options,
+    std::bitset<kFieldsCount>& found_fields) const;
+
+ private:
+  std::tuple<FieldBinding<StructType, FieldTypes>...> fields_;
+};
+
+template<typename StructType, typename... FieldTypes>
+constexpr Binding<StructType, FieldTypes...> MakeBinding(FieldBinding<StructType, FieldTypes>... fields) {
+  return {fields...};
+};
+
+template<typename StructType, typename... FieldTypes>
+template<typename PredType, typename ApplyType>
+bool Binding<StructType, FieldTypes...>::Visit(PredType&& pred, ApplyType&& apply) const {
+  return [&]<std::size_t... Inds>(std::index_sequence<Inds...>) {
+    return ((pred(std::get<Inds>(fields_), Inds) ? (apply(std::get<Inds>(fields_), Inds), true) : false) || ...);
+  }(std::index_sequence_for<FieldTypes...>{});
+};
+
+template<typename StructType, typename... FieldTypes>
+template<IsArgvRange RangeType>
+bool Binding<StructType, FieldTypes...>::Parse(RangeType&& argv, StructType& options) const {
+  constexpr std::string_view options_terminator = "--";
+
+  std::bitset<kFieldsCount> found_fields;
+  try {
+    auto argv_itr = std::ranges::begin(argv);
+    auto argv_end = std::ranges::end(argv);
+    bool is_terminated = false;
+    for (; argv_itr != argv_end; ++argv_itr) {
+      std::string_view token = *argv_itr;
+      if (!is_terminated && token == options_terminator) {
+        is_terminated = true;
+      } else if (!is_terminated && token.size() > 1 && token.starts_with('-') &&
+        !(token[1] >= '0' && token[1] <= '9')) {
+        ParseOption(argv_itr, argv_end, options, found_fields);
+      } else {
+        ParsePositional(token, options, found_fields);
+      }
+    }
+
+    Visit([&found_fields](const auto& field, std::size_t ind) {
+      return field.is_required && !found_fields[ind];
+    }, [](const auto& field, std::size_t) {
+      binding::ThrowParseFail("cannot find arg", field.full_name);
+    });
+  } catch (std::runtime_error& ex){
+#ifdef PARSER_VERBOSE
+    std::cerr << ex.what() << std::endl;
+#endif
+    return false;
+  }
+
+  return true;
+};
+
+template<typename StructType, typename... FieldTypes>
+template<typename InItr, typename EndType>
+void Binding<StructType, FieldTypes...>::ParseOption(InItr& argv_itr, EndType argv_end,
+  StructType& options, std::bitset<kFieldsCount>& found_fields) const {
+  std::string_view token = *argv_itr;
+
+  // value of the option is glued by "=" (short one also as "-n5") or is the next token
+  auto apply = [&](const auto& field, std::size_t ind, std::string_view glued_value, bool is_glued) {
+    using FieldType = std::remove_reference_t<decltype(options.*field.member)>;
+    found_fields.set(ind);
+    if constexpr (binding::kIsFlag<FieldType>) {
+      if (is_glued)
+        binding::ThrowParseFail("flag does not take value", token);
+      options.*field.member = true;
+    } else {
+      std::string_view value = glued_value;
+      if (!is_glued) {
+        if (++argv_itr == argv_end)
+          binding::ThrowParseFail("value is not found", token);
+        value = *argv_itr;
+      }
+      if (!binding::ConvertField(value, options.*field.member))
+        binding::ThrowParseFail("cannot convert arg", value);
+    }
+  };
+
+  if (token.starts_with("--")) {
+    std::string_view name = token.substr(2);
+    std::string_view glued_value;
+    auto separator_pos = name.find('=');
+    if (separator_pos != name.npos) {
+      glued_value = name.substr(separator_pos + 1);
+      name = name.substr(0, separator_pos);
+    }
+
+    if (!Visit([name](const auto& field, std::size_t) { return field.full_name == name; },
+      [&](const auto& field, std::size_t ind) {
+        apply(field, ind, glued_value, separator_pos != std::string_view::npos);
+      }))
+      binding::ThrowParseFail("argument found, but not registrated", token);
+    return;
+  }
+
+  // "-abc" are flags, the first option with value takes the rest of the token
+  for (std::size_t pos = 1; pos < token.size(); ++pos) {
+    bool is_value_taken = false;
+    if (!Visit([symbol = token[pos]](const auto& field, std::size_t) { return field.short_name == symbol; },
+      [&](const auto& field, std::size_t ind) {
+        using FieldType = std::remove_reference_t<decltype(options.*field.member)>;
+        std::string_view rest = token.substr(pos + 1);
+        if constexpr (binding::kIsFlag<FieldType>) {
+          apply(field, ind, rest, false);
+        } else {
+          if (rest.starts_with('='))
+            rest.remove_prefix(1);
+          apply(field, ind, rest, !rest.empty());
+          is_value_taken = true;
+        }
+      }))
+      binding::ThrowParseFail("argument found, but not registrated", token);
+    if (is_value_taken)
+      return;
+  }
+};
+
+template<typename StructType, typename... FieldTypes>
+void Binding<StructType, FieldTypes...>::ParsePositional(std::string_view token, StructType& options,
+  std::bitset<kFieldsCount>& found_fields) const {
+  // positional fields are filled in order, list field takes all the rest
+  if (!Visit([&found_fields, &options](const auto& field, std::size_t ind) {
+      using FieldType = std::remove_reference_t<decltype(options.*field.member)>;
+      return field.is_positional && (binding::kIsList<FieldType> || !found_fields[ind]);
+    }, [&](const auto& field, std::size_t ind) {
+      found_fields.set(ind);
+      if (!binding::ConvertField(token, options.*field.member))
+        binding::ThrowParseFail("cannot convert arg", token);
+    }))
+    binding::ThrowParseFail("positional value is not expected", token);
+};
+
+} // argument_parser
+
+#endif // _BINDING_HPP_
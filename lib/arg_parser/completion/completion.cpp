@@ -0,0 +1,80 @@
+#include "completion.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef PARSER_VERBOSE
+#include <iostream>
+#endif
+
+namespace argument_parser {
+
+namespace {
+
+// name of shell function, symbols of path are not allowed there
+std::string GetFunctionName(std::string_view program) {
+  std::string function_name = "_";
+  for (char symbol : program.substr(program.find_last_of('/') + 1)) {
+    bool is_word = (symbol >= 'a' && symbol <= 'z') || (symbol >= 'A' && symbol <= 'Z') ||
+      (symbol >= '0' && symbol <= '9');
+    function_name += is_word ? symbol : '_';
+  }
+  function_name += "_complete";
+  return function_name;
+};
+
+} // namespace
+
+std::string MakeCompletionScript(Shell shell, std::string_view program) {
+  std::string function_name = GetFunctionName(program);
+  std::string command_name(program.substr(program.find_last_of('/') + 1));
+  std::string script;
+
+  if (shell == Shell::BASH) {
+    script += function_name + "() {\n";
+    script += "  local IFS=$'\\n'\n";
+    script += "  COMPREPLY=($('" + std::string(program) + "' complete \"$COMP_POINT\" \"$COMP_LINE\"))\n";
+    // "=" splits words of bash, so only the value part is replaced
+    script += "  local line=\"${COMP_LINE:0:COMP_POINT}\"\n";
+    script += "  if [[ \"${line##* }\" == *=* ]]; then\n";
+    script += "    COMPREPLY=(\"${COMPREPLY[@]#*=}\")\n";
+    script += "  fi\n";
+    script += "}\n";
+    script += "complete -o default -F " + function_name + " " + command_name + "\n";
+  } else {
+    script += "#compdef " + command_name + "\n";
+    script += function_name + "() {\n";
+    script += "  local -a candidates\n";
+    script += "  candidates=(\"${(@f)$('" + std::string(program) + "' complete \"$CURSOR\" \"$BUFFER\")}\")\n";
+    script += "  [[ -n \"$candidates\" ]] && compadd -Q -- $candidates\n";
+    script += "}\n";
+    script += "compdef " + function_name + " " + command_name + "\n";
+  }
+  return script;
+};
+
+bool SplitCompletionLine(std::string_view line, std::size_t cursor, TokenizerDevice& tokenizer,
+  std::vector<std::string_view>& words) {
+  words.clear();
+  line = line.substr(0, std::min(cursor, line.size()));
+  try {
+    tokenizer.Run(line);
+  } catch (std::runtime_error& ex){
+#ifdef PARSER_VERBOSE
+    std::cerr << ex.what() << std::endl;
+#endif
+    return false;
+  }
+
+  // program name is not completed
+  const auto& tokens = tokenizer.GetTokens();
+  if (tokens.empty())
+    return true;
+  words.assign(tokens.begin() + 1, tokens.end());
+  // cursor after blank starts new word
+  if (line.back() == ' ' || line.back() == '\t')
+    words.emplace_back();
+  return true;
+};
+
+} // argument_parser
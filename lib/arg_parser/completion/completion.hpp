@@ -0,0 +1,27 @@
+#ifndef _COMPLETION_HPP_
+#define _COMPLETION_HPP_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <lib/arg_parser/tokenizer/tokenizer.hpp>
+
+namespace argument_parser {
+
+enum class Shell { BASH, ZSH };
+
+// script for the shell, candidates are printed by "program complete <cursor> <line>"
+// one per line, as COMP_POINT and COMP_LINE of bash or CURSOR and BUFFER of zsh
+std::string MakeCompletionScript(Shell shell, std::string_view program);
+
+// words of line before cursor without program name, none while it is typed; the last one
+// is under cursor and empty after blank. false for unterminated quote, words point into
+// line or tokenizer
+bool SplitCompletionLine(std::string_view line, std::size_t cursor, TokenizerDevice& tokenizer,
+  std::vector<std::string_view>& words);
+
+} // argument_parser
+
+#endif // _COMPLETION_HPP_
@@ -0,0 +1,154 @@
+#include "config.hpp"
+
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include <lib/arg_parser/profile/allocation.hpp>
+
+namespace argument_parser {
+
+namespace {
+
+std::string_view Trim(std::string_view str) {
+  constexpr std::string_view spaces = " \t\r";
+  auto begin = str.find_first_not_of(spaces);
+  if (begin == str.npos)
+    return {};
+  return str.substr(begin, str.find_last_not_of(spaces) - begin + 1);
+};
+
+std::string_view Unquote(std::string_view str) {
+  if (str.size() > 1 && (str.front() == '"' || str.front() == '\'') && str.back() == str.front())
+    return str.substr(1, str.size() - 2);
+  return str;
+};
+
+// fnv-1a, values are ended by "\n" which they cannot contain
+std::uint64_t HashValues(std::span<const std::string_view> values) {
+  if (values.empty())
+    return 0;
+  std::uint64_t hash = 14695981039346656037ull;
+  for (auto value : values) {
+    for (char symbol : value) {
+      hash = (hash ^ static_cast<unsigned char>(symbol)) * 1099511628211ull;
+    }
+    hash = (hash ^ '\n') * 1099511628211ull;
+  }
+  return hash;
+};
+
+[[noreturn]] void ThrowMalformed(std::size_t line, std::string_view line_data) {
+  allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+  std::string error_message = "config fail, malformed line ";
+  error_message += std::to_string(line);
+  error_message += ":\n   \"";
+  error_message += line_data;
+  error_message += "\"";
+  throw std::runtime_error(error_message);
+};
+
+} // namespace
+
+void ConfigFile::Map(const std::string& path) {
+  Clear();
+  mapping_.Map(path, true);
+  text_ = mapping_.GetData();
+  Tokenize();
+};
+
+void ConfigFile::Run(std::string_view text) {
+  Clear();
+  text_ = text;
+  Tokenize();
+};
+
+void ConfigFile::Clear() {
+  mapping_.Unmap();
+  text_ = {};
+  entries_.clear();
+  offsets_.clear();
+  values_.clear();
+  hashes_.clear();
+};
+
+void ConfigFile::Tokenize() {
+  std::string_view section;
+  std::string_view rest = text_;
+  for (std::size_t line = 1; !rest.empty(); ++line) {
+    auto line_end = rest.find('\n');
+    auto line_data = Trim(rest.substr(0, line_end));
+    rest = line_end == rest.npos ? std::string_view{} : rest.substr(line_end + 1);
+
+    if (line_data.empty() || line_data.front() == '#' || line_data.front() == ';')
+      continue;
+
+    if (line_data.front() == '[') {
+      if (line_data.back() != ']')
+        ThrowMalformed(line, line_data);
+      section = Trim(line_data.substr(1, line_data.size() - 2));
+      continue;
+    }
+
+    auto separator = line_data.find('=');
+    auto key = Trim(line_data.substr(0, separator));
+    if (key.empty())
+      ThrowMalformed(line, line_data);
+
+    std::string_view value;
+    if (separator != line_data.npos)
+      value = Unquote(Trim(line_data.substr(separator + 1)));
+    entries_.push_back({section, key, value, line});
+  }
+};
+
+void ConfigFile::Resolve(const NameTrie& names, std::size_t slots_count, bool is_strict) {
+  // counting sort of values by slot, entries of one slot keep order of the text
+  std::vector<NameTrie::SlotType> entry_slots;
+  entry_slots.reserve(entries_.size());
+  offsets_.assign(slots_count + 1, 0);
+  for (auto&& entry : entries_) {
+    auto slot = entry.section.empty() ? names.Find(entry.key) : names.Find(entry.section, entry.key);
+    if (slot >= slots_count) {
+      if (is_strict) {
+        allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+        std::string error_message = "config fail, unknown option on line ";
+        error_message += std::to_string(entry.line);
+        error_message += ":\n   \"";
+        error_message += entry.key;
+        error_message += "\"";
+        throw std::runtime_error(error_message);
+      }
+      slot = NameTrie::kNotFound;
+    } else {
+      ++offsets_[slot + 1];
+    }
+    entry_slots.push_back(slot);
+  }
+  std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+  values_.resize(offsets_.back());
+  std::vector<std::uint32_t> cursors(offsets_.begin(), offsets_.end() - 1);
+  for (std::size_t entry_ind = 0; entry_ind < entries_.size(); ++entry_ind) {
+    auto slot = entry_slots[entry_ind];
+    if (slot != NameTrie::kNotFound)
+      values_[cursors[slot]++] = entries_[entry_ind].value;
+  }
+
+  hashes_.resize(slots_count);
+  for (std::size_t slot = 0; slot < slots_count; ++slot) {
+    hashes_[slot] = HashValues(GetValues(slot));
+  }
+};
+
+std::span<const std::string_view> ConfigFile::GetValues(std::size_t slot) const {
+  if (slot + 1 >= offsets_.size())
+    return {};
+  return std::span<const std::string_view>(values_).subspan(offsets_[slot], offsets_[slot + 1] - offsets_[slot]);
+};
+
+std::uint64_t ConfigFile::GetHash(std::size_t slot) const {
+  return slot < hashes_.size() ? hashes_[slot] : 0;
+};
+
+} // argument_parser
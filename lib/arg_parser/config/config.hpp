@@ -0,0 +1,63 @@
+#ifndef _CONFIG_HPP_
+#define _CONFIG_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <lib/arg_parser/mapping/mapping.hpp>
+#include <lib/arg_parser/trie/trie.hpp>
+
+namespace argument_parser {
+
+// "key = value" lines with "[section]" headers, "#" and ";" comment lines;
+// key of section is "section.key", line with key only is occurrence of a flag.
+// entries point into the text, nothing is copied
+class ConfigFile {
+ public:
+  struct Entry {
+    std::string_view section;
+    std::string_view key;
+    std::string_view value;
+    std::size_t line;
+  };
+
+ public:
+  // file is mapped into memory and kept mapped until the next Map, Run or Clear
+  void Map(const std::string& path);
+  // text must outlive the entries
+  void Run(std::string_view text);
+  void Clear();
+
+  // values of entries grouped by slot of the name in order of the text,
+  // not matched names fail in strict mode and are skipped otherwise
+  void Resolve(const NameTrie& names, std::size_t slots_count, bool is_strict);
+  std::span<const std::string_view> GetValues(std::size_t slot) const;
+  // hash of values of slot, 0 if there are no values; kept apart from the text,
+  // so values of replaced or rewritten file are compared without reading it
+  std::uint64_t GetHash(std::size_t slot) const;
+
+  inline bool Empty() const { return entries_.empty(); };
+  inline std::span<const Entry> GetEntries() const { return entries_; };
+  inline std::string_view GetText() const { return text_; };
+
+ private:
+  void Tokenize();
+
+ private:
+  MappedFile mapping_;
+  std::string_view text_;
+
+  std::vector<Entry> entries_;
+  // values of slot are values_[offsets_[slot], offsets_[slot + 1])
+  std::vector<std::uint32_t> offsets_;
+  std::vector<std::string_view> values_;
+  std::vector<std::uint64_t> hashes_;
+};
+
+} // argument_parser
+
+#endif // _CONFIG_HPP_
@@ -0,0 +1,48 @@
+#include "environment.hpp"
+
+#include <cstring>
+
+#include <unistd.h>
+
+namespace argument_parser {
+
+void EnvironmentIndex::SetNames(const std::vector<std::string_view>& names) {
+  values_.clear();
+  values_.reserve(names.size());
+  for (auto name : names) {
+    values_.try_emplace(name);
+  }
+};
+
+void EnvironmentIndex::Scan(char** environment) {
+  for (auto&& [name, value] : values_) {
+    value.is_set = false;
+  }
+  if (values_.empty() || !environment)
+    return;
+
+  // the first of repeated variables wins, as for getenv
+  for (; *environment; ++environment) {
+    const char* entry = *environment;
+    const char* separator = std::strchr(entry, '=');
+    if (!separator)
+      continue;
+
+    auto value_itr = values_.find(std::string_view(entry, separator - entry));
+    if (value_itr != values_.end() && !value_itr->second.is_set)
+      value_itr->second = {separator + 1, true};
+  }
+};
+
+const std::string_view* EnvironmentIndex::Find(std::string_view name) const {
+  auto value_itr = values_.find(name);
+  if (value_itr == values_.end() || !value_itr->second.is_set)
+    return nullptr;
+  return &value_itr->second.value;
+};
+
+char** GetProcessEnvironment() {
+  return environ;
+};
+
+} // argument_parser
@@ -0,0 +1,37 @@
+#ifndef _ENVIRONMENT_HPP_
+#define _ENVIRONMENT_HPP_
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace argument_parser {
+
+// values of declared variables only, environ is scanned once per Scan
+class EnvironmentIndex {
+ public:
+  // names are hashed once, while schema is the same
+  void SetNames(const std::vector<std::string_view>& names);
+  // environment is "NAME=value" array ended by nullptr, as environ
+  void Scan(char** environment);
+
+  inline bool Empty() const { return values_.empty(); };
+  // nullptr if the variable is not set
+  const std::string_view* Find(std::string_view name) const;
+
+ private:
+  struct ValueType {
+    std::string_view value;
+    bool is_set = false;
+  };
+
+ private:
+  std::unordered_map<std::string_view, ValueType> values_;
+};
+
+// environ of the process
+char** GetProcessEnvironment();
+
+} // argument_parser
+
+#endif // _ENVIRONMENT_HPP_
@@ -0,0 +1,119 @@
+#include "help.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace argument_parser {
+
+void HelpLayout::Build(std::span<const Argument> args, std::size_t width) {
+  names_cont_.clear();
+  lines_cont_.clear();
+  lines_offsets_.clear();
+
+  std::size_t names_width = 0;
+  for (auto&& arg : args) {
+    std::string names(kIndent, ' ');
+    if (arg.IsPositional()) {
+      names += arg.GetFullName();
+    } else {
+      if (!arg.GetShortName().empty()) {
+        names += '-';
+        names += arg.GetShortName();
+        names += ", ";
+      } else {
+        names += "    ";
+      }
+      names += "--";
+      names += arg.GetFullName();
+    }
+    if (arg.GetStorePtr() && !arg.IsValueless()) {
+      names += " <";
+      names += arg.GetStrStoreType();
+      names += '>';
+      if (arg.IsMultivalue())
+        names += "...";
+    }
+    if (names.size() <= kIndent + kMaxNamesWidth)
+      names_width = std::max(names_width, names.size());
+    names_cont_.push_back(std::move(names));
+  }
+
+  std::size_t description_column = names_width + kGap;
+  std::size_t description_width = width > description_column + kMinDescriptionWidth ?
+    width - description_column : kMinDescriptionWidth;
+
+  // the text size is counted before it is written, so it is allocated once
+  std::size_t text_size = 0;
+  for (std::size_t ind = 0; ind < args.size(); ++ind) {
+    lines_offsets_.push_back(lines_cont_.size());
+    wrap(args[ind].GetDescription(), description_width);
+
+    std::size_t lines_begin = lines_offsets_.back();
+    bool is_own_line = names_cont_[ind].size() > names_width && lines_begin != lines_cont_.size();
+    text_size += names_cont_[ind].size() + is_own_line + 1;
+    for (std::size_t line = lines_begin; line < lines_cont_.size(); ++line) {
+      bool is_first_line = line == lines_begin && !is_own_line;
+      text_size += (is_first_line ? description_column - names_cont_[ind].size() : description_column) +
+        lines_cont_[line].size + (line + 1 != lines_cont_.size());
+    }
+  }
+  lines_offsets_.push_back(lines_cont_.size());
+
+  text_.clear();
+  text_.reserve(text_size);
+  for (std::size_t ind = 0; ind < args.size(); ++ind) {
+    std::string_view description = args[ind].GetDescription();
+    const auto& names = names_cont_[ind];
+    text_ += names;
+    bool is_own_line = names.size() > names_width && lines_offsets_[ind] != lines_offsets_[ind + 1];
+    if (is_own_line)
+      text_ += '\n';
+    for (std::size_t line = lines_offsets_[ind]; line < lines_offsets_[ind + 1]; ++line) {
+      bool is_first_line = line == lines_offsets_[ind] && !is_own_line;
+      text_.append(is_first_line ? description_column - names.size() : description_column, ' ');
+      text_.append(description.substr(lines_cont_[line].begin, lines_cont_[line].size));
+      if (line + 1 != lines_offsets_[ind + 1])
+        text_ += '\n';
+    }
+    text_ += '\n';
+  }
+};
+
+void HelpLayout::wrap(std::string_view description, std::size_t width) {
+  std::size_t pos = 0;
+  while (pos < description.size()) {
+    std::size_t paragraph_end = std::min(description.find('\n', pos), description.size());
+    // the first line of empty paragraph is kept, so "\n\n" gives empty line
+    bool is_empty_paragraph = true;
+    while (pos < paragraph_end || is_empty_paragraph) {
+      is_empty_paragraph = false;
+      while (pos < paragraph_end && description[pos] == ' ') {
+        ++pos;
+      }
+      std::size_t line_end = pos;
+      std::size_t word_end = pos;
+      while (word_end < paragraph_end) {
+        std::size_t next_space = std::min(description.find(' ', word_end), paragraph_end);
+        // too long word takes the whole line
+        if (next_space - pos > width && line_end != pos)
+          break;
+        line_end = next_space;
+        word_end = next_space;
+        while (word_end < paragraph_end && description[word_end] == ' ') {
+          ++word_end;
+        }
+      }
+      lines_cont_.push_back({pos, line_end - pos});
+      pos = word_end;
+    }
+    pos = paragraph_end + 1;
+  }
+};
+
+std::size_t HelpLayout::Write(std::span<char> buffer) const {
+  if (buffer.size() >= text_.size())
+    std::memcpy(buffer.data(), text_.data(), text_.size());
+  return text_.size();
+};
+
+} // argument_parser
@@ -0,0 +1,57 @@
+#ifndef _HELP_HPP_
+#define _HELP_HPP_
+
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <lib/arg_parser/argument/argument.hpp>
+
+namespace argument_parser {
+
+// help text is laid out once for registrated arguments and then only copied out:
+//   -s, --name <type>   description wrapped to the width
+//                       of the terminal
+// names longer than kMaxNamesWidth start their description on the next line
+class HelpLayout {
+ public:
+  static constexpr std::size_t kDefaultWidth = 80;
+  static constexpr std::size_t kMaxNamesWidth = 32;
+  static constexpr std::size_t kMinDescriptionWidth = 20;
+  static constexpr std::size_t kIndent = 2;
+  static constexpr std::size_t kGap = 2;
+
+ public:
+  void Build(std::span<const Argument> args, std::size_t width);
+  inline void Clear() { text_.clear(); };
+
+  inline void Write(std::ostream& stream) const {
+    stream.write(text_.data(), static_cast<std::streamsize>(text_.size()));
+  };
+  // size of the whole text, nothing is written into smaller buffer
+  std::size_t Write(std::span<char> buffer) const;
+  inline std::string_view GetText() const { return text_; };
+
+ private:
+  struct Line {
+    std::size_t begin;
+    std::size_t size;
+  };
+
+  // lines of description are appended, "\n" of description breaks line too
+  void wrap(std::string_view description, std::size_t width);
+
+ private:
+  std::string text_;
+  std::vector<std::string> names_cont_;
+  std::vector<Line> lines_cont_;
+  // lines of i-th argument are [lines_offsets_[i], lines_offsets_[i + 1])
+  std::vector<std::size_t> lines_offsets_;
+};
+
+} // argument_parser
+
+#endif // _HELP_HPP_
@@ -1,5 +1,6 @@
 #include "lexer.hpp"
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <string_view>
@@ -9,7 +10,7 @@ namespace argument_parser {
 
 namespace lexeme {
 
-Lexeme::Lexeme(std::string_view value) : value_(value) {  };
+Lexeme::Lexeme(std::string_view value, std::string_view token) : value_(value), token_(token) {  };
 
 std::shared_ptr<lexeme::Lexeme> Lexeme::GetOwner() { return nullptr; };
 
@@ -17,24 +18,83 @@ void Lexeme::SetOwner(std::shared_ptr<lexeme::Lexeme> new_owner_ptr) {  };
 
 Lexeme::~Lexeme() {  };
 
-Value::Value(std::string_view value) : Lexeme(value) {  };
+Value::Value(std::string_view value, std::string_view token) : Lexeme(value, token) {  };
 
 std::shared_ptr<lexeme::Lexeme> Value::GetOwner() { return owner_ptr; };
 
 void Value::SetOwner(std::shared_ptr<lexeme::Lexeme> new_owner_ptr) { owner_ptr = std::shared_ptr<Lexeme>(new_owner_ptr); };
 
-FullName::FullName(std::string_view value) : Lexeme(value) {  };
+FullName::FullName(std::string_view value, std::string_view token) : Lexeme(value, token) {  };
 
-ShortName::ShortName(std::string_view value) : Lexeme(value) {  };
+ShortName::ShortName(std::string_view value, std::string_view token) : Lexeme(value, token) {  };
 
 } // lexeme
 
-void LexerDevice::Run(const std::vector<std::string_view>& argv, std::vector<Argument>& arguments) {
-  auto strong_split_argv = StrongSplit(std::begin(argv), std::end(argv));
+namespace {
 
-  Lexing(std::begin(strong_split_argv), std::end(strong_split_argv));
-  SemanticLexing(std::begin(arguments), std::end(arguments));
+template<typename LexemeType>
+void PushBackLexeme(LexerDevice::LexemContType& cont,
+ std::string_view::iterator begin_itr, std::string_view::iterator end_itr,
+ std::string_view token) {
+  cont.emplace_back(
+    std::make_shared<LexemeType>(
+      std::string_view(begin_itr, end_itr), token));
 };
 
+bool IsNumber(std::string_view short_argument) {
+  if (short_argument.size() > 1 && (short_argument[1] >= '0' && short_argument[1] <= '9'))
+    return true;
+  return false;
+};
+
+} // namespace
+
+void LexerDevice::Lexing(std::string_view token) {
+  constexpr std::string_view separator_charapter = "=";
+
+  // only option is splited, so value "key=value" reaches a store untouched
+  if (auto separator_pos = token.find(separator_charapter);
+    token.starts_with('-') && separator_pos != token.npos) {
+    LexingPart(token.substr(0, separator_pos), token);
+    LexingPart(token.substr(separator_pos + 1), token);
+  } else {
+    LexingPart(token, token);
+  }
+};
+
+void LexerDevice::LexingPart(std::string_view arg, std::string_view token) {
+  constexpr std::string_view short_argument_prefix = "-";
+  constexpr std::string_view full_argument_prefix = "--";
+
+  if (arg.starts_with(full_argument_prefix)) {
+    PushBackLexeme<lexeme::FullName>(lexemes_cont_,
+      arg.begin() + full_argument_prefix.size(),
+      arg.end(), token);
+  } else if (arg.starts_with(short_argument_prefix) &&
+    !IsNumber(arg) && arg.size() == 2) {
+    PushBackLexeme<lexeme::ShortName>(lexemes_cont_,
+      arg.begin() + short_argument_prefix.size(),
+      arg.end(), token);
+  } else if (arg.starts_with(short_argument_prefix) &&
+    !IsNumber(arg) && arg.size() > 2) {
+      for (auto beg_itr = std::begin(arg) + 1, end_itr = std::end(arg);
+        beg_itr != end_itr; ++beg_itr) {
+        PushBackLexeme<lexeme::ShortName>(lexemes_cont_,
+        beg_itr,
+        beg_itr + 1, token);
+        }
+  } else {
+    PushBackLexeme<lexeme::Value>(lexemes_cont_,
+      arg.begin(),
+      arg.end(), token);
+  }
+};
+
+std::span<const std::string_view> LexerDevice::MovePassThrough(std::vector<std::string_view>& storage) {
+  if (pass_through_.data() != pass_through_cont_.data())
+    return pass_through_;
+  storage = std::move(pass_through_cont_);
+  return storage;
+};
 
 } // argument_parser
\ No newline at end of file
@@ -1,31 +1,38 @@
 #ifndef _LEXER_HPP_
 #define _LEXER_HPP_
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <vector>
+#include <string>
 #include <string_view>
 #include <algorithm>
 #include <type_traits>
 #include <iterator>
+#include <ranges>
 #include <utility>
 
-#include <argument/argument.hpp>
+#include <lib/arg_parser/argument/argument.hpp>
+#include <lib/arg_parser/profile/allocation.hpp>
+#include <lib/arg_parser/trie/trie.hpp>
 
 namespace argument_parser {
 
 namespace lexeme {
 
   struct Lexeme {
-    Lexeme(std::string_view value);
+    Lexeme(std::string_view value, std::string_view token);
     virtual std::shared_ptr<Lexeme> GetOwner();
     virtual void SetOwner(std::shared_ptr<Lexeme> new_owner_ptr);
     virtual ~Lexeme() = 0;
     std::string_view value_;
+    std::string_view token_; // whole argv token, which the lexeme was cut from
   };
 
   struct Value : public Lexeme {
-    Value(std::string_view value);
+    Value(std::string_view value, std::string_view token);
     ~Value() override = default;
     std::shared_ptr<Lexeme> GetOwner() override;
     void SetOwner(std::shared_ptr<Lexeme> new_owner_ptr) override;
@@ -33,12 +40,12 @@ namespace lexeme {
   };
 
   struct FullName : public Lexeme {
-    FullName(std::string_view value);
+    FullName(std::string_view value, std::string_view token);
     ~FullName() override = default;
   };
 
   struct ShortName : public Lexeme {
-    ShortName(std::string_view value);
+    ShortName(std::string_view value, std::string_view token);
     ~ShortName() override = default;
   };
 
@@ -51,113 +58,125 @@ concept is_arg_cont_itr = requires(InItr itr) {
   std::input_iterator<InItr>;
   {itr->IsMultivalue()} -> std::same_as<bool>;
   {itr->IsPositional()} -> std::same_as<bool>;
+  {itr->IsValueless()} -> std::same_as<bool>;
   {itr->GetFullName()} -> std::same_as<std::string_view>;
   {itr->GetShortName()} -> std::same_as<std::string_view>;
 };
 
 } // namespace
 
+// any single pass range of string-like tokens; std::string is taken only by reference,
+// because lexemes point into the tokens
+template<typename RangeType>
+concept IsArgvRange = std::ranges::input_range<RangeType> &&
+  std::convertible_to<std::ranges::range_reference_t<RangeType>, std::string_view> &&
+  (std::is_lvalue_reference_v<std::ranges::range_reference_t<RangeType>> ||
+    !std::is_same_v<std::remove_cvref_t<std::ranges::range_reference_t<RangeType>>, std::string>);
+
 class LexerDevice {
  public:
   using LexemContType = std::vector<std::shared_ptr<lexeme::Lexeme>>;
  public:
-  void Run(const std::vector<std::string_view>& argv, std::vector<Argument>& arguments);
+  // full names are found by the trie of the arguments, which slots are argument indexes
+  LexerDevice(const NameTrie& full_names, bool is_strict = true, std::uint64_t generation = 0,
+    bool is_abbreviation = false)
+    : full_names_(&full_names), is_strict_(is_strict), generation_(generation),
+      is_abbreviation_(is_abbreviation) {  };
+
+  template<IsArgvRange RangeType>
+  void Run(RangeType&& argv, std::vector<Argument>& arguments);
+  // lexing stops on the first token of help option, the rest of argv is not read
+  inline void SetHelp(std::string_view full_name, std::string_view short_name) {
+    help_full_name_ = full_name;
+    help_short_name_ = short_name;
+  };
+  inline bool IsHelpRequested() const { return is_help_requested_; };
   inline LexemContType GetLexemes() { return lexemes_cont_; };
   inline LexemContType GetPositionalCandidats() { return position_lexemes_cont_; };
+  // lexemes are moved out, so the lexer is empty after it
   inline std::pair<LexemContType, LexemContType> GetData() {
-     return {lexemes_cont_, position_lexemes_cont_};
+     return {std::move(lexemes_cont_), std::move(position_lexemes_cont_)};
   };
+  inline std::span<const std::string_view> GetPassThrough() const { return pass_through_; };
+  // pass through of not contiguous argv is copied by the lexer, storage moves to caller
+  std::span<const std::string_view> MovePassThrough(std::vector<std::string_view>& storage);
+  inline const std::vector<std::string_view>& GetUnknown() const { return unknown_cont_; };
+  // index of the first whole token which is not an option or its value, values are taken
+  // as Run does, but arguments are not marked; argv.size() if there is none before "--"
+  template<is_arg_cont_itr InItr>
+  std::size_t FindFirstPositional(std::span<const std::string_view> argv, InItr arguments_begin,
+    InItr arguments_end);
 
  private:
-  template<std::input_iterator InItr>
-  std::vector<std::string_view>
-    StrongSplit(InItr argv_begin, InItr argv_end);
-
-  template<std::input_iterator InItr>
-  void Lexing(InItr argv_begin, InItr argv_end);
+  inline bool IsHelpToken(std::string_view token) const {
+    if (token.starts_with("--"))
+      return !help_full_name_.empty() && token.substr(2) == help_full_name_;
+    return !help_short_name_.empty() && token.starts_with('-') && token.substr(1) == help_short_name_;
+  };
+  // option token is splited on the first "=", parts are lexed in place
+  void Lexing(std::string_view token);
+  void LexingPart(std::string_view arg, std::string_view token);
 
   template<is_arg_cont_itr InItr>
   void SemanticLexing(InItr arguments_begin, InItr arguments_end);
+  // values are given to name lexemes by status of their arguments
+  template<typename StatusType>
+  void AssignOwners(StatusType&& get_status);
  private:
   LexemContType position_lexemes_cont_;
   LexemContType lexemes_cont_;
+  std::span<const std::string_view> pass_through_;
+  std::vector<std::string_view> pass_through_cont_;
+  std::vector<std::string_view> unknown_cont_;
+  const NameTrie* full_names_;
+  bool is_strict_ = true;
+  // parse generation, matched arguments are synced to it before they are marked
+  std::uint64_t generation_ = 0;
+  // unique prefix of full name is accepted, "--verb" for "--verbose"
+  bool is_abbreviation_ = false;
+  std::string_view help_full_name_;
+  std::string_view help_short_name_;
+  bool is_help_requested_ = false;
 };
 
 
-template<std::input_iterator InItr>
-std::vector<std::string_view>
-  LexerDevice::StrongSplit(InItr argv_begin, InItr argv_end) {
-  constexpr std::string_view separator_charapter = "=";
-
-  std::vector<std::string_view> strong_split_argv;
-
-  for(;argv_begin != argv_end; ++argv_begin) {
-    auto& arg = *argv_begin;
-    if (auto separator_pos = arg.find(separator_charapter);
-      separator_pos != arg.npos) {
-      strong_split_argv.emplace_back(
-        arg.begin(),
-        arg.begin() + separator_pos);
-      strong_split_argv.emplace_back(
-        arg.begin() + separator_pos + 1,
-        arg.end());
-    } else {
-      strong_split_argv.emplace_back(std::move(arg));
+template<IsArgvRange RangeType>
+void LexerDevice::Run(RangeType&& argv, std::vector<Argument>& arguments) {
+  allocation::PhaseScope lexeme_phase(allocation::Phase::LEXEME);
+  constexpr std::string_view options_terminator = "--";
+
+  // most tokens give one lexeme, so the storage mostly grows once
+  if constexpr (std::ranges::sized_range<RangeType>)
+    lexemes_cont_.reserve(std::ranges::size(argv));
+
+  auto argv_itr = std::ranges::begin(argv);
+  auto argv_end = std::ranges::end(argv);
+  for (; argv_itr != argv_end; ++argv_itr) {
+    std::string_view token = *argv_itr;
+    if (token == options_terminator)
+      break;
+    if (IsHelpToken(token)) {
+      is_help_requested_ = true;
+      return;
     }
+    Lexing(token);
   }
 
-  return strong_split_argv;
-};
-
-namespace {
-
-template<typename LexemeType>
-void PushBackLexeme(LexerDevice::LexemContType& cont,
- std::string_view::iterator begin_itr, std::string_view::iterator end_itr) {
-  cont.emplace_back(
-    std::make_shared<LexemeType>(
-      std::string_view(begin_itr, end_itr)));
-};
-
-bool IsNumber(std::string_view short_argument) {
-  if (short_argument.size() > 1 && (short_argument[1] >= '0' && short_argument[1] <= '9'))
-    return true;
-  return false;
-};
-
-} // namespace
-
-
-template<std::input_iterator InItr>
-void LexerDevice::Lexing(InItr argv_begin, InItr argv_end) {
-  constexpr std::string_view short_argument_prefix = "-";
-  constexpr std::string_view full_argument_prefix = "--";
-
-  for (;argv_begin != argv_end; ++argv_begin) {
-    auto& arg = *argv_begin;
-    if (arg.starts_with(full_argument_prefix)) {
-      PushBackLexeme<lexeme::FullName>(lexemes_cont_,
-        arg.begin() + full_argument_prefix.size(),
-        arg.end());
-    } else if (arg.starts_with(short_argument_prefix) &&
-      !IsNumber(arg) && arg.size() == 2) {
-      PushBackLexeme<lexeme::ShortName>(lexemes_cont_,
-        arg.begin() + short_argument_prefix.size(),
-        arg.end());
-    } else if (arg.starts_with(short_argument_prefix) &&
-      !IsNumber(arg) && arg.size() > 2) {
-        for (auto beg_itr = std::begin(arg) + 1, end_itr = std::end(arg);
-          beg_itr != end_itr; ++beg_itr) {
-          PushBackLexeme<lexeme::ShortName>(lexemes_cont_,
-          beg_itr,
-          beg_itr + 1);
-          }
+  if (argv_itr != argv_end) {
+    ++argv_itr;
+    using ValueType = std::ranges::range_value_t<RangeType>;
+    if constexpr (std::ranges::contiguous_range<RangeType> && std::ranges::sized_range<RangeType> &&
+      std::is_same_v<ValueType, std::string_view>) {
+      pass_through_ = {std::to_address(argv_itr), std::ranges::data(argv) + std::ranges::size(argv)};
     } else {
-      PushBackLexeme<lexeme::Value>(lexemes_cont_,
-        arg.begin(),
-        arg.end());
+      for (; argv_itr != argv_end; ++argv_itr) {
+        pass_through_cont_.emplace_back(*argv_itr);
+      }
+      pass_through_ = pass_through_cont_;
     }
   }
+
+  SemanticLexing(std::begin(arguments), std::end(arguments));
 };
 
 namespace {
@@ -165,110 +184,100 @@ namespace {
 enum SearchArgStatus {
   MULTIVALUE, UNITVALUE, NOT_FOUND, FLAG,
   POSITIONAL_UNITVALUE, POSITIONAL_MULTIVALUE,
+  UNKNOWN,
+};
+
+// found arguments are marked only by kIsMarking, otherwise the status is just looked up
+template<bool kIsMarking, typename ArgumentType>
+SearchArgStatus GetSearchStatus(ArgumentType& arg) {
+  if (arg.IsValueless()) {
+    if constexpr (kIsMarking)
+      arg.occur();
+    return SearchArgStatus::FLAG;
+  }
+  if (arg.IsMultivalue() && arg.IsPositional()) {
+    return SearchArgStatus::POSITIONAL_MULTIVALUE;
+  } else if (!arg.IsMultivalue() && arg.IsPositional()) {
+    return SearchArgStatus::POSITIONAL_UNITVALUE;
+  } else if (arg.IsMultivalue() && !arg.IsPositional()) {
+    return SearchArgStatus::MULTIVALUE;
+  } else {
+    return SearchArgStatus::UNITVALUE;
+  }
 };
 
-template<typename NameType, is_arg_cont_itr InItr>
-SearchArgStatus IsContainLexeme(InItr begin_itr, InItr end_itr, lexeme::Lexeme& arg_lexeme) {
+template<typename NameType, bool kIsMarking, is_arg_cont_itr InItr>
+SearchArgStatus IsContainLexeme(InItr begin_itr, InItr end_itr, lexeme::Lexeme& arg_lexeme,
+  std::uint64_t generation, const NameTrie* full_names, bool is_abbreviation) {
   if constexpr (std::is_same_v<NameType, lexeme::ShortName>) { // instance by short argname
     if (auto res_itr = std::find_if(begin_itr, end_itr,
-      [&arg_lexeme](std::iterator_traits<decltype(begin_itr)>::reference arg) {
+      [&arg_lexeme, generation](std::iterator_traits<decltype(begin_itr)>::reference arg) {
         if (arg_lexeme.value_ == arg.GetShortName()) {
-          arg.WasFound();
+          if constexpr (kIsMarking) {
+            arg.Sync(generation);
+            arg.WasFound();
+          }
           return true;
         } else {
           return false;
         }
     }); res_itr != end_itr) {
-      try {
-        if (typeid(*(res_itr->GetStorePtr())) == typeid(Store<bool>&)) {
-          std::for_each(begin_itr, end_itr,
-            [&arg_lexeme](std::iterator_traits<decltype(begin_itr)>::reference arg) {
-            if (arg_lexeme.value_ == arg.GetShortName())
-              arg.convert("1");
-          });
-
-          return SearchArgStatus::FLAG;
-        }
-      } catch (const std::bad_typeid& ex) {
-#ifdef PARSER_VERBOSE
-        std::cout << ex.what() << '\n';
-#endif
-        // i need it for labwork task
-        // return SearchArgStatus::NOT_FOUND;
-      }
-      if (res_itr->IsMultivalue() && res_itr->IsPositional()) {
-        return SearchArgStatus::POSITIONAL_MULTIVALUE;
-      } else if (!res_itr->IsMultivalue() && res_itr->IsPositional()) {
-        return SearchArgStatus::POSITIONAL_UNITVALUE;
-      } else if (res_itr->IsMultivalue() && !res_itr->IsPositional()) {
-        return SearchArgStatus::MULTIVALUE;
-      } else {
-        return SearchArgStatus::UNITVALUE;
-      }
+      return GetSearchStatus<kIsMarking>(*res_itr);
     } else {
       return SearchArgStatus::NOT_FOUND;
     }
   } else if constexpr (std::is_same_v<NameType, lexeme::FullName>) { // instance by full argname
-    if (auto res_itr = std::find_if(begin_itr, end_itr,
-      [&arg_lexeme](std::iterator_traits<decltype(begin_itr)>::reference arg) {
-        if (arg_lexeme.value_ == arg.GetFullName()) {
-          arg.WasFound();
-          return true;
-        } else {
-          return false;
-        }
-    }); res_itr != end_itr) {
-      try {
-        if (typeid(*(res_itr->GetStorePtr())) == typeid(Store<bool>&)) {
-          std::for_each(begin_itr, end_itr,
-            [&arg_lexeme](std::iterator_traits<decltype(begin_itr)>::reference arg) {
-            if (arg_lexeme.value_ == arg.GetFullName())
-              arg.convert("1");
-          });
-          return SearchArgStatus::FLAG;
-        }
-      } catch (const std::bad_typeid& ex) {
-#ifdef PARSER_VERBOSE
-        std::cout << ex.what() << '\n';
-#endif
-        // i need it for labwork task
-        // return SearchArgStatus::NOT_FOUND;
-      }
-      if (res_itr->IsMultivalue() && res_itr->IsPositional()) {
-        return SearchArgStatus::POSITIONAL_MULTIVALUE;
-      } else if (!res_itr->IsMultivalue() && res_itr->IsPositional()) {
-        return SearchArgStatus::POSITIONAL_UNITVALUE;
-      } else if (res_itr->IsMultivalue() && !res_itr->IsPositional()) {
-        return SearchArgStatus::MULTIVALUE;
-      } else {
-        return SearchArgStatus::UNITVALUE;
-      }
-    } else {
+    // trie slot is index of the argument, abbreviated name is replaced by full one for parser
+    auto slot = is_abbreviation ? full_names->FindPrefix(arg_lexeme.value_) : full_names->Find(arg_lexeme.value_);
+    if (slot == NameTrie::kAmbiguous) {
+      allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+      std::string error_message = "Argument is ambiguous:\n   \"";
+      error_message += arg_lexeme.value_;
+      error_message += "\"\n";
+      throw std::runtime_error(error_message);
+    } else if (slot == NameTrie::kNotFound) {
       return SearchArgStatus::NOT_FOUND;
     }
+
+    auto res_itr = std::next(begin_itr, slot);
+    if constexpr (kIsMarking) {
+      res_itr->Sync(generation);
+      res_itr->WasFound();
+    }
+    arg_lexeme.value_ = res_itr->GetFullName();
+    return GetSearchStatus<kIsMarking>(*res_itr);
   } else { // another types is baned
     static_assert(true, "lexeme is not flagname type");
   }
 };
 
-template<std::input_iterator InItr>
-SearchArgStatus CheckStatus(InItr begin_itr, InItr end_itr, lexeme::Lexeme& arg_lexeme) {
+template<bool kIsMarking, std::input_iterator InItr>
+SearchArgStatus CheckStatus(InItr begin_itr, InItr end_itr, lexeme::Lexeme& arg_lexeme,
+  bool is_strict, std::uint64_t generation, const NameTrie* full_names, bool is_abbreviation) {
   try {
     if (typeid(arg_lexeme) == typeid(lexeme::ShortName)) {
-      if (auto search_res = IsContainLexeme<lexeme::ShortName>(begin_itr, end_itr, arg_lexeme);
+      if (auto search_res = IsContainLexeme<lexeme::ShortName, kIsMarking>(begin_itr, end_itr, arg_lexeme, generation,
+        full_names, is_abbreviation);
         search_res != SearchArgStatus::NOT_FOUND) {
         return search_res;
+      } else if (!is_strict) {
+        return SearchArgStatus::UNKNOWN;
       } else {
+        allocation::PhaseScope error_phase(allocation::Phase::ERROR);
         std::string error_message = "Argument found, but not retistrate:   \"";
         error_message += arg_lexeme.value_;
         error_message += "\"\n";
         throw std::runtime_error(error_message);
       }
     } else if (typeid(arg_lexeme) == typeid(lexeme::FullName)) {
-      if (auto search_res = IsContainLexeme<lexeme::FullName>(begin_itr, end_itr, arg_lexeme);
+      if (auto search_res = IsContainLexeme<lexeme::FullName, kIsMarking>(begin_itr, end_itr, arg_lexeme, generation,
+        full_names, is_abbreviation);
         search_res != SearchArgStatus::NOT_FOUND) {
         return search_res;
+      } else if (!is_strict) {
+        return SearchArgStatus::UNKNOWN;
       } else {
+        allocation::PhaseScope error_phase(allocation::Phase::ERROR);
         std::string error_message = "Argument found, but not retistrate:\n   \"";
         error_message += arg_lexeme.value_;
         error_message += "\"\n";
@@ -308,26 +317,98 @@ auto SetOwnerByItr(InItr begin_itr, InItr end_itr, std::shared_ptr<lexeme::Lexem
   return begin_itr;
 };
 
+inline bool IsValueLexeme(const std::shared_ptr<lexeme::Lexeme>& lexeme_ptr) {
+  try {
+    return lexeme_ptr && typeid(*lexeme_ptr) == typeid(lexeme::Value);
+  } catch (const std::bad_typeid& ex) {
+#ifdef PARSER_VERBOSE
+    std::cout << ex.what() << '\n';
+#endif
+  }
+  return false;
+};
+
+// unknown option is kept as whole argv token with its value glued by "=", the next token
+// is left for positional arguments, since unknown option may be a flag
+template<std::random_access_iterator RAItr>
+auto SkipUnknown(RAItr begin_itr, RAItr end_itr, std::vector<std::string_view>& unknown_cont) {
+  std::string_view token = (*begin_itr)->token_;
+  if (unknown_cont.empty() || unknown_cont.back().data() != token.data()) {
+    unknown_cont.push_back(token);
+  }
+
+  for (auto next_itr = begin_itr + 1; next_itr != end_itr &&
+    (*next_itr)->token_.data() == token.data() && IsValueLexeme(*next_itr); ++next_itr) {
+    next_itr->reset();
+    begin_itr = next_itr;
+  }
+  return begin_itr;
+};
+
 } // namespace
 
-template<is_arg_cont_itr InItr>
-void LexerDevice::SemanticLexing(InItr arguments_begin, InItr arguments_end) {
+template<typename StatusType>
+void LexerDevice::AssignOwners(StatusType&& get_status) {
   for (auto begin_itr = std::begin(lexemes_cont_), end_itr = std::end(lexemes_cont_);
     begin_itr != end_itr; ++begin_itr) {
 
-    auto status = CheckStatus(arguments_begin, arguments_end, **begin_itr);
+    auto status = get_status(**begin_itr);
     if (status == SearchArgStatus::FLAG) {
       // begin_itr->WasFound();
+    } else if (status == SearchArgStatus::UNKNOWN) {
+      begin_itr = SkipUnknown(begin_itr, end_itr, unknown_cont_);
     } else if (status == SearchArgStatus::MULTIVALUE) {
       begin_itr = SetOwnerToRange(begin_itr + 1, end_itr, *begin_itr);
     } else if (status == SearchArgStatus::UNITVALUE) {
       begin_itr = SetOwnerByItr(begin_itr + 1, end_itr, *begin_itr);
     }
+    // option without value is the last lexeme
+    if (begin_itr == end_itr)
+      break;
   }
+};
+
+template<is_arg_cont_itr InItr>
+std::size_t LexerDevice::FindFirstPositional(std::span<const std::string_view> argv, InItr arguments_begin,
+  InItr arguments_end) {
+  constexpr std::string_view options_terminator = "--";
+
+  // first lexeme of every token, so the found lexeme is turned back into argv index
+  std::vector<std::size_t> token_begins;
+  token_begins.reserve(argv.size());
+  for (std::size_t ind = 0; ind < argv.size() && argv[ind] != options_terminator; ++ind) {
+    token_begins.push_back(lexemes_cont_.size());
+    Lexing(argv[ind]);
+  }
+
+  AssignOwners([&](lexeme::Lexeme& arg_lexeme) {
+    return CheckStatus<false>(arguments_begin, arguments_end, arg_lexeme, is_strict_, generation_,
+      full_names_, is_abbreviation_);
+  });
+  for (std::size_t lexeme_ind = 0; lexeme_ind < lexemes_cont_.size(); ++lexeme_ind) {
+    auto& elem = lexemes_cont_[lexeme_ind];
+    // value glued to an option by "=" is not a whole token
+    if (IsValueLexeme(elem) && !elem->GetOwner() && elem->value_.size() == elem->token_.size()) {
+      return std::upper_bound(token_begins.begin(), token_begins.end(), lexeme_ind) - token_begins.begin() - 1;
+    }
+  }
+  return argv.size();
+};
+
+template<is_arg_cont_itr InItr>
+void LexerDevice::SemanticLexing(InItr arguments_begin, InItr arguments_end) {
+  AssignOwners([&](lexeme::Lexeme& arg_lexeme) {
+    return CheckStatus<true>(arguments_begin, arguments_end, arg_lexeme, is_strict_, generation_,
+      full_names_, is_abbreviation_);
+  });
 
   LexemContType position_candidats_cont;
   LexemContType clear_lexemes_cont;
+  position_candidats_cont.reserve(lexemes_cont_.size());
+  clear_lexemes_cont.reserve(lexemes_cont_.size());
   for (auto&& elem : lexemes_cont_) {
+    if (!elem)
+      continue;
     try {
       if (typeid(*elem) == typeid(lexeme::Value)) {
         if(elem->GetOwner()) {
@@ -0,0 +1,63 @@
+#include "mapping.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace argument_parser {
+
+MappedFile::MappedFile(MappedFile&& value)
+  : mapping_(std::exchange(value.mapping_, nullptr)), size_(std::exchange(value.size_, 0)) {  };
+
+MappedFile& MappedFile::operator=(MappedFile&& value) {
+  if (this != &value) {
+    Unmap();
+    mapping_ = std::exchange(value.mapping_, nullptr);
+    size_ = std::exchange(value.size_, 0);
+  }
+  return *this;
+};
+
+MappedFile::~MappedFile() {
+  Unmap();
+};
+
+void MappedFile::Map(const std::string& path, bool is_sequential) {
+  Unmap();
+
+  int file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0)
+    throw std::runtime_error("map fail, cannot open file:\n   " + path);
+
+  struct stat file_stat;
+  if (::fstat(file, &file_stat) < 0) {
+    ::close(file);
+    throw std::runtime_error("map fail, cannot stat file:\n   " + path);
+  }
+
+  if (file_stat.st_size > 0) {
+    void* mapping = ::mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(file);
+      throw std::runtime_error("map fail, cannot map file:\n   " + path);
+    }
+    if (is_sequential)
+      ::madvise(mapping, file_stat.st_size, MADV_SEQUENTIAL);
+    mapping_ = mapping;
+    size_ = file_stat.st_size;
+  }
+  ::close(file);
+};
+
+void MappedFile::Unmap() {
+  if (mapping_)
+    ::munmap(mapping_, size_);
+  mapping_ = nullptr;
+  size_ = 0;
+};
+
+} // argument_parser
@@ -0,0 +1,34 @@
+#ifndef _MAPPING_HPP_
+#define _MAPPING_HPP_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace argument_parser {
+
+// read-only mapping of a whole file, empty file is empty data without mapping
+class MappedFile {
+ public:
+  MappedFile() = default;
+  MappedFile(const MappedFile& value) = delete;
+  MappedFile(MappedFile&& value);
+  MappedFile& operator=(MappedFile&& value);
+  ~MappedFile();
+
+ public:
+  // the previous file is unmapped, throws runtime_error if the file cannot be mapped
+  void Map(const std::string& path, bool is_sequential = false);
+  void Unmap();
+
+  inline std::string_view GetData() const { return {static_cast<const char*>(mapping_), size_}; };
+  inline bool IsMapped() const { return mapping_; };
+
+ private:
+  void* mapping_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+} // argument_parser
+
+#endif // _MAPPING_HPP_
@@ -4,26 +4,35 @@
 
 #include <lexer/lexer.hpp>
 #include <argument/argument.hpp>
+#include <validator/validator.hpp>
+#include <environment/environment.hpp>
+#include <config/config.hpp>
+#include <profile/allocation.hpp>
 
 namespace argument_parser {
 
-void ParserDevice::Run(std::vector<Argument>& args,
+void ParserDevice::Run(std::vector<Argument>& args, ValidatorDevice& validator,
   const LexerDevice::LexemContType& positional_lexemes_cont,
   const LexerDevice::LexemContType& lexemes_cont) {
+  allocation::PhaseScope conversion_phase(allocation::Phase::CONVERSION);
   decltype(auto) pos_lex_beg = std::begin(positional_lexemes_cont);
   decltype(auto) pos_lex_end = std::end(positional_lexemes_cont);
 
-  for (auto&& arg : args) {
+  validator.Begin();
+
+  for (std::size_t arg_ind = 0; arg_ind < args.size(); ++arg_ind) {
+    auto& arg = args[arg_ind];
+    arg.Sync(generation_);
     if (arg.IsPositional()) {
       bool is_parse = true;
       if (arg.IsMultivalue()) {
-        while (is_parse && pos_lex_beg != pos_lex_end) {
-          is_parse = arg.convert((*pos_lex_beg)->value_);
-          if (is_parse) {
-            ++pos_lex_beg;
-          }
+        std::vector<std::string_view> values_cont;
+        values_cont.reserve(pos_lex_end - pos_lex_beg);
+        for (auto lex_itr = pos_lex_beg; lex_itr != pos_lex_end; ++lex_itr) {
+          values_cont.push_back((*lex_itr)->value_);
         }
-      } else {
+        pos_lex_beg += arg.convert(values_cont, parallel_threshold_);
+      } else if (pos_lex_beg != pos_lex_end) {
         is_parse = arg.convert((*pos_lex_beg)->value_);
         if (is_parse) {
           ++pos_lex_beg;
@@ -42,6 +51,7 @@ void ParserDevice::Run(std::vector<Argument>& args,
             lexeme->GetOwner()->value_ == arg.GetShortName()) {
           bool is_parse = arg.convert(lexeme->value_);
           if (!is_parse && arg.GetStatus() != Argument::WAS_INITIALIZE) {
+            allocation::PhaseScope error_phase(allocation::Phase::ERROR);
             std::string error_message = "parse fail, cannot convert arg\n   from value: ";
             error_message += lexeme->value_;
             error_message += "\n   to argument: ";
@@ -51,35 +61,38 @@ void ParserDevice::Run(std::vector<Argument>& args,
         }
       }
     }
+    if (arg.GetSource() != Argument::COMMAND_LINE)
+      RunFallback(arg, arg_ind);
+    validator.Mark(arg_ind, arg.GetStatus());
   }
 
-  for (auto&& arg : args) {
-    if (arg.GetStatus() == Argument::FoundClasses::NOT_FOUND) {
-      std::string error_message = "parse fail, cannot find arg\n   full name: ";
-      error_message += arg.GetFullName();
-      error_message += "\n   short name: ";
-      error_message += arg.GetShortName();
-      throw std::runtime_error(error_message);
-    } else if (arg.GetStatus() == Argument::FoundClasses::WAS_FOUND) {
-#ifdef PARSER_VERBOSE
-      std::cerr << "Arg was not initialized:\n" 
-        << "   full name: " << arg.GetFullName() << "\n"
-        << "   short name: " << arg.GetShortName() << std::endl;
-#endif
+  validator.Run(args);
+};
+
+void ParserDevice::RunFallback(Argument& arg, std::size_t slot) {
+  if (environment_ && !arg.GetEnvironment().empty()) {
+    const auto* env_value = environment_->Find(arg.GetEnvironment());
+    if (env_value) {
+      if (!arg.convert_environment(*env_value)) {
+        allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+        std::string error_message = "parse fail, cannot convert arg\n   from environment: ";
+        error_message += arg.GetEnvironment();
+        error_message += "=";
+        error_message += *env_value;
+        error_message += "\n   to argument: ";
+        error_message += arg.GetFullName();
+        throw std::runtime_error(error_message);
+      }
+      return;
     }
   }
 
-#if LABA4
-  for (auto&& arg : args) {
-    if (arg.IsMultivalue() && arg.min_val > arg.GetStoreCount()) {
-      std::string error_message = "parse fail, minimal count of multivalue not found arg\n   full name: ";
-      error_message += arg.GetFullName();
-      error_message += "\n   short name: ";
-      error_message += arg.GetShortName();
-      throw std::runtime_error(error_message);
-    }
+  if (config_ && !arg.convert_config(config_->GetValues(slot))) {
+    allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+    std::string error_message = "parse fail, cannot convert arg\n   from config file to argument: ";
+    error_message += arg.GetFullName();
+    throw std::runtime_error(error_message);
   }
-#endif // LABA4
 };
 
 }
\ No newline at end of file
@@ -1,16 +1,40 @@
 #ifndef _PARSER_HPP_
 #define _PARSER_HPP_
 
+#include <cstdint>
+
 #include <lexer/lexer.hpp>
 #include <argument/argument.hpp>
+#include <validator/validator.hpp>
+#include <environment/environment.hpp>
+#include <config/config.hpp>
 
 namespace argument_parser {
 
 class ParserDevice {
  public:
-  static void Run(std::vector<Argument>& args,
+  ParserDevice(std::size_t parallel_threshold = parallel::kDefaultThreshold,
+    std::uint64_t generation = 0, const EnvironmentIndex* environment = nullptr,
+    const ConfigFile* config = nullptr)
+    : parallel_threshold_(parallel_threshold), generation_(generation),
+    environment_(environment), config_(config) {  };
+
+  void Run(std::vector<Argument>& args, ValidatorDevice& validator,
     const LexerDevice::LexemContType& positional_lexemes_cont,
     const LexerDevice::LexemContType& lexemes_cont);
+
+ private:
+  // argument not found in command line takes value of its variable, then of config file
+  void RunFallback(Argument& arg, std::size_t slot);
+
+ private:
+  // positional multivalue list not shorter than it is converted by chunks in parallel
+  std::size_t parallel_threshold_;
+  // every argument is synced to the parse generation before it is parsed
+  std::uint64_t generation_;
+  const EnvironmentIndex* environment_;
+  // resolved config file, values are grouped by slot
+  const ConfigFile* config_;
 };
 
 }
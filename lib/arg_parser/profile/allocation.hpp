@@ -0,0 +1,102 @@
+#ifndef _ALLOCATION_HPP_
+#define _ALLOCATION_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace argument_parser {
+
+// allocations of parse are counted per phase of this thread; the counters are filled
+// by operator new of allocation_hook.hpp, without it they stay zero
+namespace allocation {
+
+// TOKENIZE is split of command line, LEXEME is lexing into shared lexemes, CONVERSION is
+// values into stores with their streams, ERROR is building of error messages
+enum class Phase : std::uint8_t { OTHER, TOKENIZE, LEXEME, CONVERSION, VALIDATION, ERROR, COUNT };
+
+inline constexpr std::size_t kPhasesCount = static_cast<std::size_t>(Phase::COUNT);
+
+inline constexpr std::array<std::string_view, kPhasesCount> kPhaseNames = {
+  "other", "tokenize", "lexeme", "conversion", "validation", "error",
+};
+
+struct Counter {
+  std::uint64_t count = 0;
+  std::uint64_t bytes = 0;
+};
+
+struct Report {
+  std::array<Counter, kPhasesCount> phases{};
+
+  inline const Counter& operator[](Phase phase) const { return phases[static_cast<std::size_t>(phase)]; };
+  inline Counter Total() const {
+    Counter total;
+    for (auto&& phase : phases) {
+      total.count += phase.count;
+      total.bytes += phase.bytes;
+    }
+    return total;
+  };
+};
+
+inline thread_local Phase current_phase = Phase::OTHER;
+inline thread_local Report counters;
+
+inline void Record(std::size_t size) {
+  auto& counter = counters.phases[static_cast<std::size_t>(current_phase)];
+  ++counter.count;
+  counter.bytes += size;
+};
+
+// allocations until the end of scope are of the phase, scopes are nested
+class PhaseScope {
+ public:
+  explicit PhaseScope(Phase phase) : previous_(current_phase) { current_phase = phase; };
+  PhaseScope(const PhaseScope&) = delete;
+  PhaseScope& operator=(const PhaseScope&) = delete;
+  ~PhaseScope() { current_phase = previous_; };
+
+ private:
+  Phase previous_;
+};
+
+// allocations of this thread since construction or Restart
+class Recorder {
+ public:
+  Recorder() : begin_(counters) {  };
+
+  inline void Restart() { begin_ = counters; };
+  inline Report Get() const {
+    Report report;
+    for (std::size_t ind = 0; ind < kPhasesCount; ++ind) {
+      report.phases[ind].count = counters.phases[ind].count - begin_.phases[ind].count;
+      report.phases[ind].bytes = counters.phases[ind].bytes - begin_.phases[ind].bytes;
+    }
+    return report;
+  };
+
+ private:
+  Report begin_;
+};
+
+// "total: 12 (480 B), lexeme: 8 (320 B), ..." phases without allocations are skipped
+inline std::ostream& operator<<(std::ostream& stream, const Report& report) {
+  auto total = report.Total();
+  stream << "total: " << total.count << " (" << total.bytes << " B)";
+  for (std::size_t ind = 0; ind < kPhasesCount; ++ind) {
+    if (report.phases[ind].count) {
+      stream << ", " << kPhaseNames[ind] << ": " << report.phases[ind].count <<
+        " (" << report.phases[ind].bytes << " B)";
+    }
+  }
+  return stream;
+};
+
+} // allocation
+
+} // argument_parser
+
+#endif // _ALLOCATION_HPP_
@@ -0,0 +1,68 @@
+#ifndef _ALLOCATION_HOOK_HPP_
+#define _ALLOCATION_HOOK_HPP_
+
+// replaces global operator new of the program, so include it into one translation unit
+// of a test or benchmark executable only; every allocation is counted by allocation::Record
+
+#include <cstdlib>
+#include <new>
+
+#include <lib/arg_parser/profile/allocation.hpp>
+
+namespace argument_parser {
+
+namespace allocation {
+
+inline void* Allocate(std::size_t size, std::size_t alignment) {
+  Record(size);
+  if (!size)
+    size = 1;
+  if (alignment <= alignof(std::max_align_t))
+    return std::malloc(size);
+  return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+};
+
+inline void* AllocateOrThrow(std::size_t size, std::size_t alignment) {
+  if (void* ptr = Allocate(size, alignment))
+    return ptr;
+  throw std::bad_alloc();
+};
+
+} // allocation
+
+} // argument_parser
+
+void* operator new(std::size_t size) {
+  return argument_parser::allocation::AllocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+  return argument_parser::allocation::AllocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return argument_parser::allocation::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return argument_parser::allocation::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return argument_parser::allocation::Allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return argument_parser::allocation::Allocate(size, alignof(std::max_align_t));
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+#endif // _ALLOCATION_HOOK_HPP_
@@ -0,0 +1,83 @@
+#include "result.hpp"
+
+#include <lib/arg_parser/schema/schema.hpp>
+
+namespace argument_parser {
+
+std::uint64_t result::GetTypeTag(const std::type_info& type) {
+  SchemaHash hash;
+  hash.Add(std::string_view(type.name()));
+  return hash.Get();
+};
+
+void ResultWriter::Begin(std::uint64_t schema_hash, std::size_t slots_count) {
+  result::Header header{result::kMagic, result::kVersion, schema_hash, 0,
+    static_cast<std::uint32_t>(slots_count), 0};
+  buffer_.clear();
+  buffer_.resize(sizeof(header) + slots_count * sizeof(result::SlotRecord));
+  std::memcpy(buffer_.data(), &header, sizeof(header));
+};
+
+void ResultWriter::Add(std::size_t slot, const Argument& arg) {
+  buffer_.resize((buffer_.size() + result::kAlignment - 1) / result::kAlignment * result::kAlignment);
+
+  result::SlotRecord record{};
+  record.status = arg.GetStatus();
+  record.source = arg.GetSource();
+  record.offset = buffer_.size();
+  if (arg.GetStorePtr()) {
+    record.kind = arg.GetStorePtr()->data_to_buffer(buffer_, record.count);
+    record.type_tag = result::GetTypeTag(arg.GetStorePtr()->GetItemType());
+  }
+  record.size = buffer_.size() - record.offset;
+
+  std::memcpy(buffer_.data() + sizeof(result::Header) + slot * sizeof(result::SlotRecord), &record, sizeof(record));
+};
+
+const std::vector<char>& ResultWriter::End() {
+  std::uint64_t size = buffer_.size();
+  std::memcpy(buffer_.data() + offsetof(result::Header, size), &size, sizeof(size));
+  return buffer_;
+};
+
+bool ResultView::Load(std::span<const char> buffer, std::uint64_t schema_hash) {
+  buffer_ = {};
+  slots_ = {};
+
+  result::Header header;
+  if (buffer.size() < sizeof(header) || reinterpret_cast<std::uintptr_t>(buffer.data()) % result::kAlignment)
+    return false;
+  std::memcpy(&header, buffer.data(), sizeof(header));
+  if (header.magic != result::kMagic || header.version != result::kVersion ||
+      header.schema_hash != schema_hash || header.size != buffer.size() ||
+      header.slots_count > (buffer.size() - sizeof(header)) / sizeof(result::SlotRecord))
+    return false;
+
+  std::span<const result::SlotRecord> slots(
+    reinterpret_cast<const result::SlotRecord*>(buffer.data() + sizeof(header)), header.slots_count);
+  for (auto&& slot : slots) {
+    if (slot.status > Argument::WAS_INITIALIZE || slot.source > Argument::COMMAND_LINE ||
+        slot.kind > DataKind::STRING_ARRAY || slot.offset % result::kAlignment ||
+        slot.offset > buffer.size() || slot.size > buffer.size() - slot.offset)
+      return false;
+
+    if (slot.kind == DataKind::STRING && slot.size != slot.count)
+      return false;
+    if (slot.kind == DataKind::STRING_ARRAY) {
+      if (slot.count > slot.size / sizeof(StringRecord))
+        return false;
+      for (std::size_t ind = 0; ind < slot.count; ++ind) {
+        StringRecord record;
+        std::memcpy(&record, buffer.data() + slot.offset + ind * sizeof(StringRecord), sizeof(record));
+        if (record.offset > slot.size || record.size > slot.size - record.offset)
+          return false;
+      }
+    }
+  }
+
+  buffer_ = buffer;
+  slots_ = slots;
+  return true;
+};
+
+} // argument_parser
@@ -0,0 +1,165 @@
+#ifndef _RESULT_HPP_
+#define _RESULT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <lib/arg_parser/argument/argument.hpp>
+#include <lib/arg_parser/argument/handle.hpp>
+#include <lib/arg_parser/store/store.hpp>
+
+namespace argument_parser {
+
+// parse result in one buffer: header, table of slots, then data of slots aligned to 8;
+// offsets are from the buffer begin, so it is read in place at any address
+namespace result {
+
+inline constexpr std::uint32_t kMagic = 0x53525041; // "APRS" in little endian
+inline constexpr std::uint32_t kVersion = 2;
+inline constexpr std::size_t kAlignment = 8;
+
+struct Header {
+  std::uint32_t magic;
+  std::uint32_t version;
+  std::uint64_t schema_hash;
+  std::uint64_t size;
+  std::uint32_t slots_count;
+  std::uint32_t reserved;
+};
+
+struct SlotRecord {
+  std::uint8_t status;
+  std::uint8_t source;
+  DataKind kind;
+  std::uint8_t reserved;
+  std::uint32_t count;
+  std::uint64_t offset;
+  std::uint64_t size;
+  // hash of typeid name of the item, so other type of the same size is not read
+  std::uint64_t type_tag;
+};
+
+std::uint64_t GetTypeTag(const std::type_info& type);
+
+} // result
+
+class ResultWriter {
+ public:
+  // buffer is reused by the next Begin
+  void Begin(std::uint64_t schema_hash, std::size_t slots_count);
+  void Add(std::size_t slot, const Argument& arg);
+  const std::vector<char>& End();
+
+ private:
+  std::vector<char> buffer_;
+};
+
+// strings of serialized multivalue argument
+class StringArrayView {
+ public:
+  StringArrayView() = default;
+  StringArrayView(const char* data, std::size_t count) : data_(data), count_(count) {  };
+
+  inline std::size_t size() const { return count_; };
+  inline bool empty() const { return !count_; };
+  std::string_view operator[](std::size_t ind) const {
+    StringRecord record;
+    std::memcpy(&record, data_ + ind * sizeof(StringRecord), sizeof(record));
+    return {data_ + record.offset, record.size};
+  };
+
+ private:
+  const char* data_ = nullptr;
+  std::size_t count_ = 0;
+};
+
+// values are read from serialized result in place: const reference for trivially
+// copyable types, string_view for strings, span or StringArrayView for multivalues
+template<typename ValueType>
+struct ResultValue {
+  using type = const ValueType&;
+};
+
+template<IsStringData ValueType>
+struct ResultValue<ValueType> {
+  using type = std::string_view;
+};
+
+template<IsContainer ValueType>
+  requires IsBytesData<typename ValueType::value_type>
+struct ResultValue<ValueType> {
+  using type = std::span<const typename ValueType::value_type>;
+};
+
+template<IsContainer ValueType>
+  requires IsStringData<typename ValueType::value_type>
+struct ResultValue<ValueType> {
+  using type = StringArrayView;
+};
+
+class ResultView {
+ public:
+  // buffer must be aligned to 8 and outlive the view; header, table and all offsets
+  // are checked once, so reads are not checked again
+  bool Load(std::span<const char> buffer, std::uint64_t schema_hash);
+
+  inline std::size_t GetSlotsCount() const { return slots_.size(); };
+  inline Argument::FoundClasses GetStatus(std::size_t slot) const {
+    return static_cast<Argument::FoundClasses>(slots_[slot].status);
+  };
+  inline Argument::ValueSource GetSource(std::size_t slot) const {
+    return static_cast<Argument::ValueSource>(slots_[slot].source);
+  };
+
+  // value of other type than serialized is empty, even of the same size
+  template<typename ValueType>
+  typename ResultValue<ValueType>::type GetValue(ArgHandle<ValueType> handle) const;
+
+ private:
+  std::span<const char> buffer_;
+  std::span<const result::SlotRecord> slots_;
+};
+
+template<typename ValueType>
+typename ResultValue<ValueType>::type ResultView::GetValue(ArgHandle<ValueType> handle) const {
+  const auto& slot = slots_[handle.GetSlot()];
+  const char* data = buffer_.data() + slot.offset;
+  if constexpr (IsStringData<ValueType>) {
+    if (slot.kind != DataKind::STRING)
+      return {};
+    return {data, slot.size};
+  } else if constexpr (IsBytesData<ValueType>) {
+    static_assert(alignof(ValueType) <= result::kAlignment);
+    static const ValueType kEmpty{};
+    static const std::uint64_t kTypeTag = result::GetTypeTag(typeid(ValueType));
+    if (slot.kind != DataKind::BYTES || slot.size != sizeof(ValueType) || slot.type_tag != kTypeTag)
+      return kEmpty;
+    return *std::launder(reinterpret_cast<const ValueType*>(data));
+  } else if constexpr (IsContainer<ValueType>) {
+    using ItemType = typename ValueType::value_type;
+    if constexpr (IsStringData<ItemType>) {
+      if (slot.kind != DataKind::STRING_ARRAY)
+        return {};
+      return {data, slot.count};
+    } else {
+      static_assert(IsBytesData<ItemType>, "item type is not serializable");
+      static_assert(alignof(ItemType) <= result::kAlignment);
+      static const std::uint64_t kTypeTag = result::GetTypeTag(typeid(ItemType));
+      if (slot.kind != DataKind::ARRAY || slot.size != slot.count * sizeof(ItemType) || slot.type_tag != kTypeTag)
+        return {};
+      return {std::launder(reinterpret_cast<const ItemType*>(data)), slot.count};
+    }
+  } else {
+    static_assert(IsBytesData<ValueType>, "value type is not serializable");
+  }
+};
+
+} // argument_parser
+
+#endif // _RESULT_HPP_
@@ -0,0 +1,124 @@
+#include "schema.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef PARSER_VERBOSE
+#include <iostream>
+#endif
+
+namespace argument_parser {
+
+namespace {
+
+// write may take only a part of the data, so it is repeated up to the end
+bool WriteAll(int file, const void* data, std::size_t size) {
+  auto begin = static_cast<const char*>(data);
+  while (size != 0) {
+    auto written = ::write(file, begin, size);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      return false;
+    begin += written;
+    size -= static_cast<std::size_t>(written);
+  }
+  return true;
+};
+
+} // namespace
+
+void SchemaHash::Add(std::string_view data) {
+  for (char symbol : data) {
+    hash_ = (hash_ ^ static_cast<unsigned char>(symbol)) * 1099511628211ull;
+  }
+  // end of the item, so "ab", "c" and "a", "bc" differ
+  hash_ = (hash_ ^ 0xff) * 1099511628211ull;
+};
+
+void SchemaHash::Add(std::uint64_t value) {
+  Add(std::string_view(reinterpret_cast<const char*>(&value), sizeof(value)));
+};
+
+bool SchemaCache::Load(const std::string& path, std::uint64_t schema_hash, std::size_t slots_count,
+  NameTrie& names) {
+  try {
+    mapping_.Map(path);
+  } catch (std::runtime_error& ex){
+#ifdef PARSER_VERBOSE
+    std::cerr << ex.what() << std::endl;
+#endif
+    return false;
+  }
+
+  auto data = mapping_.GetData();
+  Header header;
+  if (data.size() < sizeof(Header))
+    return false;
+  std::memcpy(&header, data.data(), sizeof(Header));
+  if (header.magic != kMagic || header.version != kVersion || header.schema_hash != schema_hash ||
+      header.slots_count != slots_count || header.nodes_count == 0 ||
+      data.size() != sizeof(Header) + header.nodes_count * sizeof(NameTrie::Node) +
+        header.edges_count * sizeof(NameTrie::Edge)) {
+    mapping_.Unmap();
+    return false;
+  }
+
+  // mapping is page aligned and arrays follow aligned header, so they are read in place
+  std::span<const NameTrie::Node> nodes(
+    reinterpret_cast<const NameTrie::Node*>(data.data() + sizeof(Header)), header.nodes_count);
+  std::span<const NameTrie::Edge> edges(
+    reinterpret_cast<const NameTrie::Edge*>(nodes.data() + nodes.size()), header.edges_count);
+
+  // damaged file must not send lookups out of the arrays
+  auto is_slot = [slots_count](NameTrie::SlotType slot) {
+    return slot < slots_count || slot == NameTrie::kNotFound || slot == NameTrie::kAmbiguous;
+  };
+  for (auto&& node : nodes) {
+    if (node.edges_begin > edges.size() || node.edges_count > edges.size() - node.edges_begin ||
+        !is_slot(node.slot) || !is_slot(node.unique_slot)) {
+      mapping_.Unmap();
+      return false;
+    }
+  }
+  for (auto&& edge : edges) {
+    if (edge.child >= nodes.size()) {
+      mapping_.Unmap();
+      return false;
+    }
+  }
+
+  names.Assign(nodes, edges);
+  return true;
+};
+
+bool SchemaCache::Store(const std::string& path, std::uint64_t schema_hash, std::size_t slots_count,
+  const NameTrie& names) {
+  auto nodes = names.GetNodes();
+  auto edges = names.GetEdges();
+  Header header{kMagic, kVersion, schema_hash, static_cast<std::uint32_t>(slots_count),
+    static_cast<std::uint32_t>(nodes.size()), static_cast<std::uint32_t>(edges.size()), 0};
+
+  // temporary name is unique for every writer, so concurrent starts do not mix their files
+  std::string temp_path = path + ".XXXXXX";
+  int file = ::mkstemp(temp_path.data());
+  if (file < 0)
+    return false;
+  bool is_written = ::fchmod(file, 0644) == 0 && WriteAll(file, &header, sizeof(header)) &&
+    WriteAll(file, nodes.data(), nodes.size_bytes()) && WriteAll(file, edges.data(), edges.size_bytes());
+  is_written = ::close(file) == 0 && is_written;
+  if (!is_written || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+    return false;
+  }
+  return true;
+};
+
+} // argument_parser
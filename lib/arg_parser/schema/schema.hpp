@@ -0,0 +1,58 @@
+#ifndef _SCHEMA_HPP_
+#define _SCHEMA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <lib/arg_parser/mapping/mapping.hpp>
+#include <lib/arg_parser/trie/trie.hpp>
+
+namespace argument_parser {
+
+// hash of what the built schema depends on, fed by names and kinds of arguments in order
+class SchemaHash {
+ public:
+  void Add(std::string_view data);
+  void Add(std::uint64_t value);
+
+  inline std::uint64_t Get() const { return hash_; };
+
+ private:
+  // fnv-1a
+  std::uint64_t hash_ = 14695981039346656037ull;
+};
+
+// built schema in a file, which is mapped and used in place:
+// header, then nodes and edges of the name trie; all links are indices
+class SchemaCache {
+ public:
+  static constexpr std::uint32_t kMagic = 0x43535041; // "APSC" in little endian
+  static constexpr std::uint32_t kVersion = 1;
+
+  struct Header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t schema_hash;
+    std::uint32_t slots_count;
+    std::uint32_t nodes_count;
+    std::uint32_t edges_count;
+    std::uint32_t reserved;
+  };
+
+ public:
+  // false if the file is missing, of other version or schema, or damaged;
+  // the trie points into the mapping, which is kept until the next Load
+  bool Load(const std::string& path, std::uint64_t schema_hash, std::size_t slots_count, NameTrie& names);
+  // written into a temporary file and renamed, so loading processes never see a part of it
+  static bool Store(const std::string& path, std::uint64_t schema_hash, std::size_t slots_count,
+    const NameTrie& names);
+
+ private:
+  MappedFile mapping_;
+};
+
+} // argument_parser
+
+#endif // _SCHEMA_HPP_
@@ -0,0 +1,156 @@
+#ifndef _RCU_HPP_
+#define _RCU_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace argument_parser {
+
+// std::hardware_destructive_interference_size is not ABI stable in gcc
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// cell of immutable value, replaced by pointer swap: readers do not wait for writers
+// and see the old or the new value whole. replaced value is freed when all readers
+// entered before the swap are gone, readers are tracked by epoch in reader slots;
+// readers over the count of slots are only counted and hold all replaced values
+template<typename ValueType, std::size_t kReaderSlots = 64>
+class RcuCell {
+ private:
+  static constexpr std::uint64_t kIdle = std::numeric_limits<std::uint64_t>::max();
+
+  // own cache line for every slot, readers of different threads do not share lines
+  struct alignas(kCacheLineSize) ReaderSlot {
+    std::atomic<std::uint64_t> epoch = kIdle;
+  };
+
+ public:
+  class ReadGuard {
+   public:
+    ReadGuard(ReadGuard&& value)
+      : slot_(std::exchange(value.slot_, nullptr)), overflow_(std::exchange(value.overflow_, nullptr)),
+      value_(std::exchange(value.value_, nullptr)) {  };
+    ReadGuard& operator=(ReadGuard&&) = delete;
+    ~ReadGuard() {
+      if (slot_)
+        slot_->epoch.store(kIdle, std::memory_order_release);
+      if (overflow_)
+        overflow_->fetch_sub(1, std::memory_order_release);
+    };
+
+    // nullptr before the first Publish
+    inline const ValueType* Get() const { return value_; };
+    inline const ValueType* operator->() const { return value_; };
+    inline const ValueType& operator*() const { return *value_; };
+    inline explicit operator bool() const { return value_; };
+
+   private:
+    friend class RcuCell;
+    ReadGuard(ReaderSlot* slot, std::atomic<std::size_t>* overflow, const ValueType* value)
+      : slot_(slot), overflow_(overflow), value_(value) {  };
+
+   private:
+    ReaderSlot* slot_;
+    std::atomic<std::size_t>* overflow_;
+    const ValueType* value_;
+  };
+
+ public:
+  RcuCell() = default;
+  // moved and destroyed cells must have no readers
+  RcuCell(RcuCell&& value)
+    : current_(value.current_.exchange(nullptr)), epoch_(value.epoch_.load()),
+    retired_(std::move(value.retired_)) {  };
+  RcuCell& operator=(RcuCell&& value) {
+    if (this != &value) {
+      delete current_.exchange(value.current_.exchange(nullptr));
+      epoch_ = value.epoch_.load();
+      retired_ = std::move(value.retired_);
+    }
+    return *this;
+  };
+  ~RcuCell() {
+    delete current_.load();
+  };
+
+  // value is valid while the guard is alive, guard is not passed to other thread
+  ReadGuard Read() const;
+  // writers are serialized, the old value is freed now or by later Publish and Reclaim
+  void Publish(std::unique_ptr<const ValueType> value);
+  // count of replaced values which are still read
+  std::size_t Reclaim();
+
+ private:
+  std::size_t reclaim_locked();
+
+ private:
+  mutable std::array<ReaderSlot, kReaderSlots> readers_;
+  // readers which found no free slot
+  alignas(kCacheLineSize) mutable std::atomic<std::size_t> overflow_readers_ = 0;
+  std::atomic<const ValueType*> current_ = nullptr;
+  std::atomic<std::uint64_t> epoch_ = 0;
+
+  std::mutex writer_mutex_;
+  // replaced values with the last epoch of readers which could see them
+  std::vector<std::pair<std::uint64_t, std::unique_ptr<const ValueType>>> retired_;
+};
+
+template<typename ValueType, std::size_t kReaderSlots>
+typename RcuCell<ValueType, kReaderSlots>::ReadGuard RcuCell<ValueType, kReaderSlots>::Read() const {
+  // threads start search from different slots, so they do not collide on the first one
+  thread_local const std::size_t slot_hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+  for (std::size_t ind = 0; ind < kReaderSlots; ++ind) {
+    auto& slot = readers_[(slot_hint + ind) % kReaderSlots];
+    std::uint64_t expected = kIdle;
+    if (slot.epoch.load(std::memory_order_relaxed) == kIdle &&
+        slot.epoch.compare_exchange_strong(expected, epoch_.load())) {
+      return ReadGuard(&slot, nullptr, current_.load());
+    }
+  }
+
+  // all slots are busy: the counted reader keeps every replaced value until it is gone,
+  // the writer sees the count or the reader sees the new pointer
+  overflow_readers_.fetch_add(1);
+  return ReadGuard(nullptr, &overflow_readers_, current_.load());
+};
+
+template<typename ValueType, std::size_t kReaderSlots>
+void RcuCell<ValueType, kReaderSlots>::Publish(std::unique_ptr<const ValueType> value) {
+  std::lock_guard lock(writer_mutex_);
+  // readers which could load the old pointer have epoch not greater than retire_epoch
+  const ValueType* old_value = current_.exchange(value.release());
+  std::uint64_t retire_epoch = epoch_.fetch_add(1);
+  if (old_value)
+    retired_.emplace_back(retire_epoch, old_value);
+  reclaim_locked();
+};
+
+template<typename ValueType, std::size_t kReaderSlots>
+std::size_t RcuCell<ValueType, kReaderSlots>::Reclaim() {
+  std::lock_guard lock(writer_mutex_);
+  return reclaim_locked();
+};
+
+template<typename ValueType, std::size_t kReaderSlots>
+std::size_t RcuCell<ValueType, kReaderSlots>::reclaim_locked() {
+  std::uint64_t min_epoch = overflow_readers_.load() ? 0 : kIdle;
+  for (auto&& slot : readers_) {
+    min_epoch = std::min(min_epoch, slot.epoch.load());
+  }
+  std::erase_if(retired_, [min_epoch](const auto& retired) { return retired.first < min_epoch; });
+  return retired_.size();
+};
+
+} // argument_parser
+
+#endif // _RCU_HPP_
@@ -0,0 +1,115 @@
+#ifndef _SNAPSHOT_HPP_
+#define _SNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <lib/arg_parser/argument/handle.hpp>
+#include <lib/arg_parser/snapshot/rcu.hpp>
+#include <lib/arg_parser/store/store.hpp>
+
+namespace argument_parser {
+
+// allocates whole cache lines, so read-only data does not share a line with written one
+template<typename ValueType>
+struct CacheLineAllocator {
+  using value_type = ValueType;
+
+  CacheLineAllocator() = default;
+  template<typename OtherType>
+  CacheLineAllocator(const CacheLineAllocator<OtherType>&) {  };
+
+  ValueType* allocate(std::size_t count) {
+    std::size_t size = (count * sizeof(ValueType) + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+    return static_cast<ValueType*>(::operator new(size, std::align_val_t(kCacheLineSize)));
+  };
+  void deallocate(ValueType* ptr, std::size_t) {
+    ::operator delete(ptr, std::align_val_t(kCacheLineSize));
+  };
+
+  template<typename OtherType>
+  bool operator==(const CacheLineAllocator<OtherType>&) const { return true; };
+};
+
+// immutable parse result, read from any thread without locks and atomics;
+// stores not changed by reload are shared with the previous snapshot
+class alignas(kCacheLineSize) ParseSnapshot {
+ public:
+  struct Entry {
+    std::shared_ptr<const BaseStore> store;
+    bool is_multivalue = false;
+  };
+
+ private:
+  // two slots in a line, small trivially copyable data is read from the slot itself
+  struct Slot {
+    const BaseStore* store = nullptr;
+    bool is_multivalue = false;
+    alignas(std::max_align_t) std::byte inline_data[kInlineDataSize];
+  };
+
+ public:
+  ParseSnapshot(std::vector<Entry> entries, std::uint64_t version);
+
+  // handle must be made by MakeHandle of the parser which published the snapshot
+  template<typename ValueType>
+  const ValueType& GetValue(ArgHandle<ValueType> handle) const;
+
+  inline std::uint64_t GetVersion() const { return version_; };
+  inline const std::vector<Entry>& GetEntries() const { return entries_; };
+
+ private:
+  std::vector<Slot, CacheLineAllocator<Slot>> slots_;
+  // incremented by every publish of the parser
+  std::uint64_t version_;
+  std::vector<Entry> entries_;
+};
+
+inline ParseSnapshot::ParseSnapshot(std::vector<Entry> entries, std::uint64_t version)
+  : slots_(entries.size()), version_(version), entries_(std::move(entries)) {
+  for (std::size_t ind = 0; ind < entries_.size(); ++ind) {
+    slots_[ind].store = entries_[ind].store.get();
+    slots_[ind].is_multivalue = entries_[ind].is_multivalue;
+    entries_[ind].store->data_to_bytes(slots_[ind].inline_data);
+  }
+};
+
+template<typename ValueType>
+const ValueType& ParseSnapshot::GetValue(ArgHandle<ValueType> handle) const {
+  const auto& slot = slots_[handle.GetSlot()];
+  if constexpr (kIsInlineData<ValueType>) {
+    return *std::launder(reinterpret_cast<const ValueType*>(slot.inline_data));
+  } else {
+    if constexpr (IsContainer<ValueType>) {
+      if (slot.is_multivalue)
+        return static_cast<const MultiValueStore<ValueType>&>(*slot.store).data_;
+    }
+    return static_cast<const Store<ValueType>&>(*slot.store).data_;
+  }
+};
+
+namespace global {
+
+inline std::shared_ptr<const ParseSnapshot> snapshot_owner;
+inline const ParseSnapshot* snapshot = nullptr;
+
+} // global
+
+// process wide snapshot for worker threads: it is set before they start and is not
+// replaced while they read, so reads are plain loads. use ArgParser::ReadSnapshot
+// for options which are reloaded
+inline void SetGlobalSnapshot(std::shared_ptr<const ParseSnapshot> snapshot) {
+  global::snapshot = snapshot.get();
+  global::snapshot_owner = std::move(snapshot);
+};
+
+inline const ParseSnapshot& GetGlobalSnapshot() {
+  return *global::snapshot;
+};
+
+} // argument_parser
+
+#endif // _SNAPSHOT_HPP_
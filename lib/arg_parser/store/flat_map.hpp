@@ -0,0 +1,97 @@
+#ifndef _FLAT_MAP_HPP_
+#define _FLAT_MAP_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace argument_parser {
+
+// sorted vector of pairs, insertion keeps order and the last value of a key,
+// lookup is heterogeneous, so std::string keys are found by string_view without allocation
+template<typename KeyType, typename ValueType>
+class FlatMap {
+ public:
+  using key_type = KeyType;
+  using mapped_type = ValueType;
+  using value_type = std::pair<KeyType, ValueType>;
+  using size_type = std::size_t;
+  using container_type = std::vector<value_type>;
+  using iterator = typename container_type::iterator;
+  using const_iterator = typename container_type::const_iterator;
+
+ public:
+  void push_back(const value_type& value) { emplace_back(value); };
+  void push_back(value_type&& value) { emplace_back(std::move(value)); };
+
+  template<typename... ConstructArgumentTypes>
+  void emplace_back(ConstructArgumentTypes&&... construct_args);
+
+  template<typename LookupType>
+  const_iterator find(const LookupType& key) const;
+
+  template<typename LookupType>
+  bool contains(const LookupType& key) const { return find(key) != end(); };
+
+  template<typename LookupType>
+  const ValueType& at(const LookupType& key) const;
+
+  inline void reserve(size_type size) { data_.reserve(size); };
+  inline void clear() { data_.clear(); };
+  inline size_type size() const { return data_.size(); };
+  inline bool empty() const { return data_.empty(); };
+
+  inline iterator begin() { return data_.begin(); };
+  inline iterator end() { return data_.end(); };
+  inline const_iterator begin() const { return data_.begin(); };
+  inline const_iterator end() const { return data_.end(); };
+
+ private:
+  template<typename LookupType>
+  static bool KeyLess(const value_type& elem, const LookupType& key) { return elem.first < key; };
+
+ private:
+  container_type data_;
+};
+
+template<typename KeyType, typename ValueType>
+template<typename... ConstructArgumentTypes>
+void FlatMap<KeyType, ValueType>::emplace_back(ConstructArgumentTypes&&... construct_args) {
+  value_type value(std::forward<ConstructArgumentTypes>(construct_args)...);
+
+  if (data_.empty() || data_.back().first < value.first) {
+    data_.push_back(std::move(value));
+    return;
+  }
+
+  auto pos_itr = std::lower_bound(data_.begin(), data_.end(), value.first, KeyLess<KeyType>);
+  if (pos_itr->first == value.first) {
+    pos_itr->second = std::move(value.second);
+  } else {
+    data_.insert(pos_itr, std::move(value));
+  }
+};
+
+template<typename KeyType, typename ValueType>
+template<typename LookupType>
+auto FlatMap<KeyType, ValueType>::find(const LookupType& key) const -> const_iterator {
+  auto pos_itr = std::lower_bound(data_.begin(), data_.end(), key, KeyLess<LookupType>);
+  if (pos_itr != data_.end() && pos_itr->first == key)
+    return pos_itr;
+  return data_.end();
+};
+
+template<typename KeyType, typename ValueType>
+template<typename LookupType>
+const ValueType& FlatMap<KeyType, ValueType>::at(const LookupType& key) const {
+  if (auto pos_itr = find(key); pos_itr != end())
+    return pos_itr->second;
+  throw std::out_of_range("FlatMap::at key is not found");
+};
+
+} // argument_parser
+
+#endif // _FLAT_MAP_HPP_
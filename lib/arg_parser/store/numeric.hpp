@@ -0,0 +1,153 @@
+#ifndef _NUMERIC_HPP_
+#define _NUMERIC_HPP_
+
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace argument_parser {
+
+namespace numeric {
+
+constexpr char kListSeparator = ',';
+
+template<typename ValueType>
+concept IsNumber = std::is_arithmetic_v<ValueType> &&
+  !std::is_same_v<ValueType, bool> && !std::is_same_v<ValueType, char>;
+
+// calls item_func for every item between separators, separators are found 16 bytes at a time
+template<typename ItemFuncType>
+bool ForEachItem(std::string_view str_data, char separator, ItemFuncType&& item_func) {
+  std::size_t item_begin = 0;
+  std::size_t ind = 0;
+#if defined(__SSE2__)
+  const __m128i pattern = _mm_set1_epi8(separator);
+  for (; ind + 16 <= str_data.size(); ind += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str_data.data() + ind));
+    for (auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern)));
+      mask; mask &= mask - 1) {
+      std::size_t separator_pos = ind + std::countr_zero(mask);
+      if (!item_func(str_data.substr(item_begin, separator_pos - item_begin)))
+        return false;
+      item_begin = separator_pos + 1;
+    }
+  }
+#endif
+  for (; ind < str_data.size(); ++ind) {
+    if (str_data[ind] == separator) {
+      if (!item_func(str_data.substr(item_begin, ind - item_begin)))
+        return false;
+      item_begin = ind + 1;
+    }
+  }
+  return item_func(str_data.substr(item_begin));
+};
+
+inline std::size_t CountSeparators(std::string_view str_data, char separator) {
+  std::size_t count = 0;
+  std::size_t ind = 0;
+#if defined(__SSE2__)
+  const __m128i pattern = _mm_set1_epi8(separator);
+  for (; ind + 16 <= str_data.size(); ind += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str_data.data() + ind));
+    count += std::popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern))));
+  }
+#endif
+  for (; ind < str_data.size(); ++ind) {
+    count += str_data[ind] == separator;
+  }
+  return count;
+};
+
+// eight ascii digits are checked and converted as one 64 bit word
+inline bool IsEightDigits(std::uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+    (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+};
+
+inline std::uint64_t ParseEightDigits(std::uint64_t chunk) {
+  chunk = ((chunk & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+  chunk = ((chunk & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+  return ((chunk & 0x0000FFFF0000FFFF) * 42949672960001) >> 32;
+};
+
+template<std::integral ValueType>
+bool ParseInteger(std::string_view str_data, ValueType& value) {
+  // explicit plus is accepted as by operator>>
+  bool is_negative = false;
+  if (str_data.starts_with('+')) {
+    str_data.remove_prefix(1);
+  } else if constexpr (std::is_signed_v<ValueType>) {
+    if (str_data.starts_with('-')) {
+      is_negative = true;
+      str_data.remove_prefix(1);
+    }
+  }
+  if (str_data.empty())
+    return false;
+
+  constexpr std::uint64_t max_value = std::numeric_limits<std::uint64_t>::max();
+  std::uint64_t result = 0;
+  std::size_t ind = 0;
+
+  if constexpr (std::endian::native == std::endian::little) {
+    for (std::uint64_t chunk; ind + 8 <= str_data.size(); ind += 8) {
+      std::memcpy(&chunk, str_data.data() + ind, sizeof(chunk));
+      if (!IsEightDigits(chunk))
+        break;
+      auto digits = ParseEightDigits(chunk);
+      if (result > (max_value - digits) / 100'000'000)
+        return false;
+      result = result * 100'000'000 + digits;
+    }
+  }
+
+  for (; ind < str_data.size(); ++ind) {
+    unsigned digit = static_cast<unsigned char>(str_data[ind]) - '0';
+    if (digit > 9 || result > (max_value - digit) / 10)
+      return false;
+    result = result * 10 + digit;
+  }
+
+  using UnsignedType = std::make_unsigned_t<ValueType>;
+  constexpr std::uint64_t max_positive = std::numeric_limits<ValueType>::max();
+  if (!is_negative) {
+    if (result > max_positive)
+      return false;
+    value = static_cast<ValueType>(result);
+  } else {
+    if (result > max_positive + 1)
+      return false;
+    value = static_cast<ValueType>(static_cast<UnsignedType>(0) - static_cast<UnsignedType>(result));
+  }
+  return true;
+};
+
+template<std::floating_point ValueType>
+bool ParseFloat(std::string_view str_data, ValueType& value) {
+  // from_chars does not take plus, the sign after it is wrong
+  if (str_data.starts_with('+')) {
+    str_data.remove_prefix(1);
+    if (str_data.starts_with('-'))
+      return false;
+  }
+  auto end = str_data.data() + str_data.size();
+  auto [ptr, ec] = std::from_chars(str_data.data(), end, value);
+  return ec == std::errc() && ptr == end;
+};
+
+} // numeric
+
+} // argument_parser
+
+#endif // _NUMERIC_HPP_
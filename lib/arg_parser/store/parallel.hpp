@@ -0,0 +1,62 @@
+#ifndef _PARALLEL_HPP_
+#define _PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace argument_parser {
+
+namespace parallel {
+
+constexpr std::size_t kDefaultThreshold = 1 << 16;
+constexpr std::size_t kMinChunkSize = 1 << 14;
+
+// converts str_data_cont[i] into out_data[i] by convert_func, chunks run on own threads
+// if the range is not less than threshold; returns index of the first failed value
+// (or size of the range), so the result does not depend on chunks order
+template<typename ValueType, typename ConvertFuncType>
+std::size_t ConvertRange(std::span<const std::string_view> str_data_cont, ValueType* out_data,
+  std::size_t threshold, ConvertFuncType convert_func) {
+  auto convert_chunk = [&str_data_cont, out_data, &convert_func](std::size_t begin, std::size_t end) {
+    for (; begin != end; ++begin) {
+      if (!convert_func(str_data_cont[begin], out_data[begin]))
+        return begin;
+    }
+    return end;
+  };
+
+  std::size_t size = str_data_cont.size();
+  std::size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t chunks_count = std::min(hardware_threads, size / kMinChunkSize);
+  if (size < threshold || chunks_count < 2)
+    return convert_chunk(0, size);
+
+  std::size_t chunk_size = (size + chunks_count - 1) / chunks_count;
+  std::vector<std::size_t> fail_cont(chunks_count, size);
+  {
+    std::vector<std::jthread> thread_cont;
+    thread_cont.reserve(chunks_count - 1);
+    for (std::size_t chunk_ind = 1; chunk_ind < chunks_count; ++chunk_ind) {
+      thread_cont.emplace_back([&, chunk_ind]() {
+        std::size_t begin = std::min(size, chunk_ind * chunk_size);
+        std::size_t end = std::min(size, begin + chunk_size);
+        if (auto fail_ind = convert_chunk(begin, end); fail_ind != end)
+          fail_cont[chunk_ind] = fail_ind;
+      });
+    }
+    if (auto fail_ind = convert_chunk(0, chunk_size); fail_ind != chunk_size)
+      fail_cont[0] = fail_ind;
+  }
+
+  return *std::min_element(fail_cont.begin(), fail_cont.end());
+};
+
+} // parallel
+
+} // argument_parser
+
+#endif // _PARALLEL_HPP_
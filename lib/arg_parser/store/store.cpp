@@ -1,5 +1,41 @@
 #include "store.hpp"
 
+#include <cstdlib>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
 namespace argument_parser {
   BaseStore::~BaseStore() {  };
+
+  std::size_t BaseStore::strings_to_data(std::span<const std::string_view> str_data_cont,
+    std::size_t) {
+    std::size_t converted_count = 0;
+    while (converted_count < str_data_cont.size() && string_to_data(str_data_cont[converted_count])) {
+      ++converted_count;
+    }
+    return converted_count;
+  };
+
+  bool BaseStore::values_to_data(std::span<const std::string_view> str_data_cont) {
+    for (auto str_data : str_data_cont) {
+      if (!(str_data.empty() && IsValueless() ? occurrence_to_data() : string_to_data(str_data)))
+        return false;
+    }
+    return true;
+  };
+
+  std::string DemangleTypeName(const char* type_name) {
+#if __has_include(<cxxabi.h>)
+    int status = 0;
+    char* demangled_name = abi::__cxa_demangle(type_name, nullptr, nullptr, &status);
+    if (status == 0 && demangled_name) {
+      std::string result(demangled_name);
+      std::free(demangled_name);
+      return result;
+    }
+#endif
+    return type_name;
+  };
 } // argument_parser
\ No newline at end of file
@@ -1,11 +1,30 @@
 #ifndef _STORE_HPP_
 #define _STORE_HPP_
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ranges>
+#include <span>
 #include <string>
-#include <sstream>
+#include <string_view>
+#include <type_traits>
+#include <spanstream>
+#include <iterator>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <lib/arg_parser/store/flat_map.hpp>
+#include <lib/arg_parser/store/numeric.hpp>
+#include <lib/arg_parser/store/parallel.hpp>
 
 namespace argument_parser {
 
+// readable name of typeid name, "unsigned long" instead of "m"
+std::string DemangleTypeName(const char* type_name);
+
 namespace {
 
 template<typename ContType>
@@ -21,6 +40,96 @@ concept IsContainer =
 
 } // namespace
 
+// conversion point of the stores, specialize it for own value types
+template<typename ValueType>
+struct Converter {
+  static bool Convert(std::string_view str_data, ValueType& value);
+  static std::string GetStrType();
+};
+
+// numbers must be matched whole, "30ka" is not int
+template<numeric::IsNumber ValueType>
+struct Converter<ValueType> {
+  static bool Convert(std::string_view str_data, ValueType& value) {
+    if constexpr (std::is_integral_v<ValueType>) {
+      return numeric::ParseInteger(str_data, value);
+    } else {
+      return numeric::ParseFloat(str_data, value);
+    }
+  };
+  static std::string GetStrType() { return DemangleTypeName(typeid(ValueType).name()); };
+};
+
+// strings are taken whole, string_view points into argv without copy
+template<>
+struct Converter<std::string> {
+  static bool Convert(std::string_view str_data, std::string& value) {
+    value.assign(str_data);
+    return true;
+  };
+  static std::string GetStrType() { return "string"; };
+};
+
+template<>
+struct Converter<std::string_view> {
+  static bool Convert(std::string_view str_data, std::string_view& value) {
+    value = str_data;
+    return true;
+  };
+  static std::string GetStrType() { return "string"; };
+};
+
+// "key=value" item, split on the first "=" so value may contain "=" too
+template<typename KeyType, typename ValueType>
+struct Converter<std::pair<KeyType, ValueType>> {
+  static bool Convert(std::string_view str_data, std::pair<KeyType, ValueType>& value) {
+    auto separator_pos = str_data.find('=');
+    if (separator_pos == str_data.npos)
+      return false;
+    return Converter<KeyType>::Convert(str_data.substr(0, separator_pos), value.first) &&
+      Converter<ValueType>::Convert(str_data.substr(separator_pos + 1), value.second);
+  };
+  static std::string GetStrType() {
+    return Converter<KeyType>::GetStrType() + "=" + Converter<ValueType>::GetStrType();
+  };
+};
+
+// small trivially copyable data is copied into read-only tables, read without indirection
+inline constexpr std::size_t kInlineDataSize = 16;
+template<typename ValueType>
+inline constexpr bool kIsInlineData = std::is_trivially_copyable_v<ValueType> &&
+  sizeof(ValueType) <= kInlineDataSize && alignof(ValueType) <= alignof(std::max_align_t);
+
+// converter of choice type lists the names of values, e.g. for shell completion
+template<typename ValueType>
+concept HasChoices = requires(std::vector<std::string_view>& choices) {
+  Converter<ValueType>::GetChoices(choices);
+};
+
+template<typename ValueType>
+concept IsStringData = std::is_same_v<ValueType, std::string> || std::is_same_v<ValueType, std::string_view>;
+
+// data serialized as its own bytes; pointers and views are trivially copyable too,
+// but their bytes point into memory of the writing process
+template<typename ValueType>
+concept IsBytesData = std::is_trivially_copyable_v<ValueType> && !IsStringData<ValueType> &&
+  !std::is_pointer_v<ValueType> && !std::is_member_pointer_v<ValueType> &&
+  !std::ranges::borrowed_range<ValueType>;
+
+// serialized form of data: BYTES is the object itself, STRING is its symbols,
+// ARRAY is items one by one, STRING_ARRAY is table of (offset, size) from the data begin
+// and then the symbols; NONE is not serializable data
+enum class DataKind : std::uint8_t { NONE, BYTES, STRING, ARRAY, STRING_ARRAY };
+
+struct StringRecord {
+  std::uint64_t offset;
+  std::uint64_t size;
+};
+
+inline void AppendBytes(std::vector<char>& buffer, const void* data, std::size_t size) {
+  buffer.insert(buffer.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+};
+
 class BaseStore {
  public:
   virtual ~BaseStore() = 0;
@@ -28,26 +137,70 @@ class BaseStore {
   virtual std::size_t GetCountOfData() const { return 0; };
 #endif
   virtual std::string GetStrType() = 0;
-  virtual bool string_to_data(const std::string& str_data) = 0;
+  // names of choice values are appended, other types have none
+  virtual void GetChoices(std::vector<std::string_view>&) const {  };
+  virtual bool string_to_data(std::string_view str_data) = 0;
+  // parsed data is replaced by default one, pointed user variable is not touched
+  virtual void reset_data() = 0;
+  // copy of the same dynamic type, for snapshots and rollback
+  virtual std::unique_ptr<BaseStore> clone() const = 0;
+#if LABA4
+  // pointed user variable is dropped, so a clone is changed apart from it
+  virtual void unbind() {  };
+  // pointed user variable of the store of the same type is taken and written by data
+  virtual void bind_as(const BaseStore&) {  };
+#endif
+  // copies data of kIsInlineData type into buffer of kInlineDataSize
+  virtual bool data_to_bytes(std::byte*) const { return false; };
+  // data is appended in serialized form, count is count of symbols or items
+  virtual DataKind data_to_buffer(std::vector<char>&, std::uint32_t&) const { return DataKind::NONE; };
+  // type of serialized item: the data itself or the element of multivalue
+  virtual const std::type_info& GetItemType() const { return typeid(void); };
+  // converts values in order until the first fail, returns count of converted values
+  virtual std::size_t strings_to_data(std::span<const std::string_view> str_data_cont,
+    std::size_t parallel_threshold);
+  // every value in order, empty value of valueless store is its occurrence
+  bool values_to_data(std::span<const std::string_view> str_data_cont);
+
+  // valueless stores (flags, counters) are filled by occurrence of the option itself
+  virtual bool IsValueless() const { return false; };
+  virtual bool occurrence_to_data() { return false; };
 };
 
 template<typename StorageType>
 class Store : public BaseStore {
  public:
   Store() = default;
-  Store(const StorageType& data) : data_(data) {  };
-  Store(StorageType&& data) : data_(std::move(data)) {  };
+  Store(const StorageType& data) : data_(data), default_(data) {  };
+  Store(StorageType&& data) : data_(data), default_(std::move(data)) {  };
   Store(const Store& value) = default;
   Store(Store&& value);
   Store& operator=(Store&& value);
   ~Store() override = default;
 
  public:
-  bool string_to_data(const std::string& str_data) override;
+  bool string_to_data(std::string_view str_data) override;
+  void reset_data() override { data_ = default_; };
+  std::unique_ptr<BaseStore> clone() const override { return std::make_unique<Store>(*this); };
+#if LABA4
+  void unbind() override { ptr_ = nullptr; };
+  void bind_as(const BaseStore& store) override;
+#endif
+  bool data_to_bytes(std::byte* buffer) const override;
+  DataKind data_to_buffer(std::vector<char>& buffer, std::uint32_t& count) const override;
+  const std::type_info& GetItemType() const override { return typeid(StorageType); };
   std::string GetStrType() override;
+  void GetChoices(std::vector<std::string_view>& choices) const override {
+    if constexpr (HasChoices<StorageType>)
+      Converter<StorageType>::GetChoices(choices);
+  };
+  bool IsValueless() const override;
+  bool occurrence_to_data() override;
 
  public:
   StorageType data_;
+  // kept apart from parsed data, so reset does not need the builder
+  StorageType default_;
 #ifdef LABA4
   StorageType* ptr_ = nullptr;
 #endif
@@ -64,48 +217,172 @@ class MultiValueStore : public BaseStore {
 
  public:
   std::string GetStrType() override;
-  bool string_to_data(const std::string& str_data) override;
+  void GetChoices(std::vector<std::string_view>& choices) const override {
+    if constexpr (HasChoices<typename StorageType::value_type>)
+      Converter<typename StorageType::value_type>::GetChoices(choices);
+  };
+  bool string_to_data(std::string_view str_data) override;
+  std::size_t strings_to_data(std::span<const std::string_view> str_data_cont,
+    std::size_t parallel_threshold) override;
+  void reset_data() override { data_ = default_; };
+  std::unique_ptr<BaseStore> clone() const override { return std::make_unique<MultiValueStore>(*this); };
+#if LABA4
+  void unbind() override { ptr_ = nullptr; };
+  void bind_as(const BaseStore& store) override;
+#endif
+  DataKind data_to_buffer(std::vector<char>& buffer, std::uint32_t& count) const override;
+  const std::type_info& GetItemType() const override { return typeid(typename StorageType::value_type); };
 #if LABA4
   std::size_t GetCountOfData() const override { return data_.size(); };
 #endif
 
+ private:
+  // "1,2,3" of numbers is converted at once into presized storage
+  bool list_to_data(std::string_view str_data);
+  // values are written into presized storage, chunks are converted in parallel
+  std::size_t range_to_data(std::span<const std::string_view> str_data_cont, std::size_t parallel_threshold);
+
  public:
   StorageType data_;
+  StorageType default_;
 #ifdef LABA4
   StorageType* ptr_ = nullptr;
 #endif
 };
 
+template<typename IntType = int>
+class CounterStore : public Store<IntType> {
+ public:
+  CounterStore() : Store<IntType>(IntType{0}) {  };
+  ~CounterStore() override = default;
+
+ public:
+  std::unique_ptr<BaseStore> clone() const override { return std::make_unique<CounterStore>(*this); };
+  bool IsValueless() const override { return true; };
+  bool occurrence_to_data() override;
+};
+
+namespace reduce {
+
+struct Sum {
+  template<typename ValueType>
+  ValueType operator()(const ValueType& accumulator, const ValueType& value) const {
+    return accumulator + value;
+  };
+};
+
+struct Max {
+  template<typename ValueType>
+  ValueType operator()(const ValueType& accumulator, const ValueType& value) const {
+    return accumulator < value ? value : accumulator;
+  };
+};
+
+struct Last {
+  template<typename ValueType>
+  ValueType operator()(const ValueType&, const ValueType& value) const {
+    return value;
+  };
+};
+
+} // reduce
+
+// folds every occurrence of the option into single value, nothing is stored per occurrence
+template<typename StorageType, typename Reducer>
+class ReduceStore : public Store<StorageType> {
+ public:
+  ReduceStore() = default;
+  ~ReduceStore() override = default;
+
+ public:
+  bool string_to_data(std::string_view str_data) override;
+  void reset_data() override {
+    Store<StorageType>::reset_data();
+    has_data_ = false;
+  };
+  std::unique_ptr<BaseStore> clone() const override { return std::make_unique<ReduceStore>(*this); };
+
+ private:
+  bool has_data_ = false;
+};
+
+template<typename ValueType>
+bool Converter<ValueType>::Convert(std::string_view str_data, ValueType& value) {
+  std::ispanstream strstr(str_data);
+
+  strstr >> value;
+  return !strstr.fail();
+};
+
+template<typename ValueType>
+std::string Converter<ValueType>::GetStrType() {
+  return DemangleTypeName(typeid(ValueType).name());
+};
+
 template<typename StorageType>
-Store<StorageType>::Store(Store&& value) : data_(std::move(value.data_)){  };
+Store<StorageType>::Store(Store&& value)
+  : data_(std::move(value.data_)), default_(std::move(value.default_)) {  };
 
 template<typename StorageType>
 Store<StorageType>& Store<StorageType>::operator=(Store&& value) {
   data_ = value.data_;
+  default_ = value.default_;
   return *this;
 };
 
 template<IsContainer StorageType>
 MultiValueStore<StorageType>::MultiValueStore(MultiValueStore&& value)
- : data_(std::move(value.data_)){  };
+ : data_(std::move(value.data_)), default_(std::move(value.default_)) {  };
 
 template<IsContainer StorageType>
 MultiValueStore<StorageType>& MultiValueStore<StorageType>::operator=(MultiValueStore&& value) {
   data_ = value.data_;
+  default_ = value.default_;
   return *this;
 };
 
+template<IsContainer StorageType>
+DataKind MultiValueStore<StorageType>::data_to_buffer(std::vector<char>& buffer, std::uint32_t& count) const {
+  using ItemType = typename StorageType::value_type;
+  count = data_.size();
+  if constexpr (IsStringData<ItemType>) {
+    std::size_t table_begin = buffer.size();
+    buffer.resize(table_begin + data_.size() * sizeof(StringRecord));
+    StringRecord record{data_.size() * sizeof(StringRecord), 0};
+    std::size_t record_ind = 0;
+    for (const ItemType& item : data_) {
+      record.size = item.size();
+      std::memcpy(buffer.data() + table_begin + record_ind++ * sizeof(StringRecord), &record, sizeof(record));
+      AppendBytes(buffer, item.data(), item.size());
+      record.offset += item.size();
+    }
+    return DataKind::STRING_ARRAY;
+  } else if constexpr (IsBytesData<ItemType>) {
+    for (const ItemType& item : data_) {
+      AppendBytes(buffer, &item, sizeof(ItemType));
+    }
+    return DataKind::ARRAY;
+  }
+  return DataKind::NONE;
+};
+
+#if LABA4
+template<IsContainer StorageType>
+void MultiValueStore<StorageType>::bind_as(const BaseStore& store) {
+  ptr_ = dynamic_cast<const MultiValueStore&>(store).ptr_;
+  if (ptr_)
+    *ptr_ = data_;
+};
+#endif
+
 template<IsContainer StorageType>
 std::string MultiValueStore<StorageType>::GetStrType() {
-  return typeid(StorageType).name();
+  return Converter<typename StorageType::value_type>::GetStrType();
 };
 
 template<typename StorageType>
-bool Store<StorageType>::string_to_data(const std::string& str_data) {
-  std::stringstream strstr(str_data);
-
-  strstr >> data_;
-  if (strstr.fail())
+bool Store<StorageType>::string_to_data(std::string_view str_data) {
+  if (!Converter<StorageType>::Convert(str_data, data_))
     return false;
 
 #ifdef LABA4
@@ -116,18 +393,63 @@ bool Store<StorageType>::string_to_data(const std::string& str_data) {
   return true;
 };
 
+#if LABA4
+template<typename StorageType>
+void Store<StorageType>::bind_as(const BaseStore& store) {
+  ptr_ = dynamic_cast<const Store&>(store).ptr_;
+  if (ptr_)
+    *ptr_ = data_;
+};
+#endif
+
+template<typename StorageType>
+bool Store<StorageType>::data_to_bytes(std::byte* buffer) const {
+  if constexpr (kIsInlineData<StorageType>) {
+    std::memcpy(buffer, &data_, sizeof(StorageType));
+    return true;
+  }
+  return false;
+};
+
+template<typename StorageType>
+DataKind Store<StorageType>::data_to_buffer(std::vector<char>& buffer, std::uint32_t& count) const {
+  if constexpr (IsStringData<StorageType>) {
+    count = data_.size();
+    AppendBytes(buffer, data_.data(), data_.size());
+    return DataKind::STRING;
+  } else if constexpr (IsBytesData<StorageType>) {
+    count = 1;
+    AppendBytes(buffer, &data_, sizeof(StorageType));
+    return DataKind::BYTES;
+  }
+  return DataKind::NONE;
+};
+
 template<typename StorageType>
 std::string Store<StorageType>::GetStrType() {
-  return typeid(StorageType).name();
+  return Converter<StorageType>::GetStrType();
+};
+
+template<typename StorageType>
+bool Store<StorageType>::IsValueless() const {
+  return false;
+};
+
+template<typename StorageType>
+bool Store<StorageType>::occurrence_to_data() {
+  return false;
 };
 
 template<IsContainer StorageType>
-bool MultiValueStore<StorageType>::string_to_data(const std::string& str_data) {
-  std::stringstream strstr(str_data);
+bool MultiValueStore<StorageType>::string_to_data(std::string_view str_data) {
+  if constexpr (numeric::IsNumber<typename StorageType::value_type>) {
+    if (str_data.find(numeric::kListSeparator) != str_data.npos)
+      return list_to_data(str_data);
+  }
+
   typename StorageType::value_type buff;
-  strstr >> buff;
 
-  if (strstr.fail())
+  if (!Converter<typename StorageType::value_type>::Convert(str_data, buff))
     return false;
 
   data_.push_back(buff);
@@ -140,6 +462,127 @@ bool MultiValueStore<StorageType>::string_to_data(const std::string& str_data) {
   return true;
 };
 
+template<IsContainer StorageType>
+std::size_t MultiValueStore<StorageType>::strings_to_data(std::span<const std::string_view> str_data_cont,
+  std::size_t parallel_threshold) {
+  using ValueType = typename StorageType::value_type;
+
+  if constexpr (requires(StorageType cont) { cont.resize(0); cont.data(); } &&
+    !std::is_same_v<ValueType, bool>) {
+    // value rejected by plain conversion gets the single value path (comma lists) before fail
+    std::size_t converted_count = 0;
+    while (converted_count < str_data_cont.size()) {
+      converted_count += range_to_data(str_data_cont.subspan(converted_count), parallel_threshold);
+      if (converted_count == str_data_cont.size() || !string_to_data(str_data_cont[converted_count]))
+        break;
+      ++converted_count;
+    }
+    return converted_count;
+  } else {
+    return BaseStore::strings_to_data(str_data_cont, parallel_threshold);
+  }
+};
+
+template<IsContainer StorageType>
+std::size_t MultiValueStore<StorageType>::range_to_data(std::span<const std::string_view> str_data_cont,
+  std::size_t parallel_threshold) {
+  using ValueType = typename StorageType::value_type;
+
+  std::size_t old_size = data_.size();
+  data_.resize(old_size + str_data_cont.size());
+
+  auto converted_count = parallel::ConvertRange(str_data_cont, data_.data() + old_size,
+    parallel_threshold, [](std::string_view str_data, ValueType& value) {
+      return Converter<ValueType>::Convert(str_data, value);
+  });
+
+  data_.resize(old_size + converted_count);
+
+#ifdef LABA4
+  if (ptr_ && converted_count)
+    *ptr_ = data_;
+#endif
+
+  return converted_count;
+};
+
+template<IsContainer StorageType>
+bool MultiValueStore<StorageType>::list_to_data(std::string_view str_data) {
+  using ValueType = typename StorageType::value_type;
+
+  std::size_t old_size = data_.size();
+  bool list_res = true;
+  if constexpr (requires(StorageType cont) { cont.resize(0); cont[0]; }) {
+    data_.resize(old_size + numeric::CountSeparators(str_data, numeric::kListSeparator) + 1);
+    auto data_itr = data_.begin() + old_size;
+    list_res = numeric::ForEachItem(str_data, numeric::kListSeparator,
+      [&data_itr](std::string_view item) {
+        return Converter<ValueType>::Convert(item, *data_itr++);
+    });
+  } else {
+    list_res = numeric::ForEachItem(str_data, numeric::kListSeparator,
+      [this](std::string_view item) {
+        ValueType buff;
+        if (!Converter<ValueType>::Convert(item, buff))
+          return false;
+        data_.push_back(buff);
+        return true;
+    });
+  }
+
+  if (!list_res) {
+    data_.erase(std::next(data_.begin(), old_size), data_.end());
+    return false;
+  }
+
+#ifdef LABA4
+  if (ptr_)
+    *ptr_ = data_;
+#endif
+
+  return true;
+};
+
+template<>
+inline bool Store<bool>::IsValueless() const { return true; };
+
+template<>
+inline bool Store<bool>::occurrence_to_data() {
+  data_ = true;
+#ifdef LABA4
+  if (ptr_)
+    *ptr_ = data_;
+#endif
+  return true;
+};
+
+template<typename IntType>
+bool CounterStore<IntType>::occurrence_to_data() {
+  ++this->data_;
+#ifdef LABA4
+  if (this->ptr_)
+    *this->ptr_ = this->data_;
+#endif
+  return true;
+};
+
+template<typename StorageType, typename Reducer>
+bool ReduceStore<StorageType, Reducer>::string_to_data(std::string_view str_data) {
+  StorageType value;
+  if (!Converter<StorageType>::Convert(str_data, value))
+    return false;
+
+  this->data_ = has_data_ ? Reducer{}(this->data_, value) : std::move(value);
+  has_data_ = true;
+
+#ifdef LABA4
+  if (this->ptr_)
+    *this->ptr_ = this->data_;
+#endif
+
+  return true;
+};
+
 } // argument_parser
 
 #endif // _STORE_HPP_
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "tokenizer.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <lib/arg_parser/profile/allocation.hpp>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace argument_parser {
+
+namespace {
+
+inline bool IsBlank(char symbol) {
+  return symbol == ' ' || symbol == '\t' || symbol == '\n';
+};
+
+// position of the first of symbols from pos, 16 bytes are compared at a time
+template<char... Symbols>
+std::size_t FindFirstOf(std::string_view str_data, std::size_t pos) {
+#if defined(__SSE2__)
+  for (; pos + 16 <= str_data.size(); pos += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str_data.data() + pos));
+    __m128i match = _mm_setzero_si128();
+    ((match = _mm_or_si128(match, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(Symbols)))), ...);
+    if (auto mask = static_cast<unsigned>(_mm_movemask_epi8(match)))
+      return pos + std::countr_zero(mask);
+  }
+#endif
+  for (; pos < str_data.size(); ++pos) {
+    if (((str_data[pos] == Symbols) || ...))
+      return pos;
+  }
+  return str_data.size();
+};
+
+void ThrowUnterminated(std::string_view command_line, std::string_view what) {
+  allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+  std::string error_message = "tokenize fail, unterminated ";
+  error_message += what;
+  error_message += "\n   in: ";
+  error_message += command_line;
+  throw std::runtime_error(error_message);
+};
+
+} // namespace
+
+void TokenizerDevice::TokenBuilder::Append(std::string_view piece) {
+  if (is_started_ && piece.empty())
+    return;
+
+  if (!is_started_) {
+    view_ = piece;
+    is_started_ = true;
+  } else if (!is_copy_ && view_.data() + view_.size() == piece.data()) {
+    view_ = std::string_view(view_.data(), view_.size() + piece.size());
+  } else {
+    if (!is_copy_) {
+      copy_.assign(view_);
+      is_copy_ = true;
+    }
+    copy_ += piece;
+  }
+};
+
+std::string_view TokenizerDevice::TokenBuilder::Finish(std::deque<std::string>& unescaped_cont) {
+  if (!is_copy_)
+    return view_;
+  unescaped_cont.push_back(std::move(copy_));
+  return unescaped_cont.back();
+};
+
+void TokenizerDevice::Run(std::string_view command_line) {
+  allocation::PhaseScope tokenize_phase(allocation::Phase::TOKENIZE);
+  tokens_.clear();
+  unescaped_cont_.clear();
+
+  std::size_t pos = 0;
+  while (true) {
+    while (pos < command_line.size() && IsBlank(command_line[pos])) {
+      ++pos;
+    }
+    if (pos >= command_line.size())
+      break;
+
+    TokenBuilder builder;
+    while (pos < command_line.size() && !IsBlank(command_line[pos])) {
+      char symbol = command_line[pos];
+      if (symbol == '\'') {
+        auto end = command_line.find('\'', pos + 1);
+        if (end == std::string_view::npos)
+          ThrowUnterminated(command_line, "single quote");
+        builder.Append(command_line.substr(pos + 1, end - pos - 1));
+        pos = end + 1;
+      } else if (symbol == '"') {
+        pos = ReadDoubleQuoted(command_line, pos + 1, builder);
+      } else if (symbol == '\\') {
+        // trailing backslash is kept, escaped newline joins lines
+        if (pos + 1 == command_line.size()) {
+          builder.Append(command_line.substr(pos, 1));
+          ++pos;
+          continue;
+        }
+        if (command_line[pos + 1] != '\n')
+          builder.Append(command_line.substr(pos + 1, 1));
+        pos += 2;
+      } else {
+        auto end = FindFirstOf<' ', '\t', '\n', '\'', '"', '\\'>(command_line, pos);
+        builder.Append(command_line.substr(pos, end - pos));
+        pos = end;
+      }
+    }
+
+    if (builder.IsStarted())
+      tokens_.push_back(builder.Finish(unescaped_cont_));
+  }
+};
+
+// inside double quotes backslash escapes only $ ` " \ and newline
+std::size_t TokenizerDevice::ReadDoubleQuoted(std::string_view command_line, std::size_t pos,
+  TokenBuilder& builder) {
+  builder.Append(command_line.substr(pos, 0));
+  while (true) {
+    auto end = FindFirstOf<'"', '\\'>(command_line, pos);
+    if (end == command_line.size())
+      ThrowUnterminated(command_line, "double quote");
+    builder.Append(command_line.substr(pos, end - pos));
+
+    if (command_line[end] == '"')
+      return end + 1;
+
+    if (end + 1 == command_line.size())
+      ThrowUnterminated(command_line, "double quote");
+    char escaped = command_line[end + 1];
+    if (escaped == '$' || escaped == '`' || escaped == '"' || escaped == '\\') {
+      builder.Append(command_line.substr(end + 1, 1));
+    } else if (escaped != '\n') {
+      builder.Append(command_line.substr(end, 2));
+    }
+    pos = end + 2;
+  }
+};
+
+} // argument_parser
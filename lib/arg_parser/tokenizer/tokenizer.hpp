@@ -0,0 +1,44 @@
+#ifndef _TOKENIZER_HPP_
+#define _TOKENIZER_HPP_
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace argument_parser {
+
+// splits whole command line by posix shell rules: blanks, '...', "..." and backslash escapes;
+// token which is one piece of the line points into it, only unescaped tokens are copied
+class TokenizerDevice {
+ public:
+  void Run(std::string_view command_line);
+
+  // tokens are valid while the command line and the tokenizer are alive and not rerun
+  inline std::vector<std::string_view>& GetTokens() { return tokens_; };
+
+ private:
+  class TokenBuilder {
+   public:
+    void Append(std::string_view piece);
+    inline bool IsStarted() const { return is_started_; };
+    std::string_view Finish(std::deque<std::string>& unescaped_cont);
+
+   private:
+    std::string_view view_;
+    std::string copy_;
+    bool is_started_ = false;
+    bool is_copy_ = false;
+  };
+
+  std::size_t ReadDoubleQuoted(std::string_view command_line, std::size_t pos, TokenBuilder& builder);
+
+ private:
+  std::vector<std::string_view> tokens_;
+  // deque does not move strings on growth, so views into them stay valid
+  std::deque<std::string> unescaped_cont_;
+};
+
+} // argument_parser
+
+#endif // _TOKENIZER_HPP_
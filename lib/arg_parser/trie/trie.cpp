@@ -0,0 +1,124 @@
+#include "trie.hpp"
+
+#include <algorithm>
+
+namespace argument_parser {
+
+void NameTrie::Build(std::vector<NameType> names) {
+  Clear();
+  std::stable_sort(names.begin(), names.end(), [](const NameType& lhs, const NameType& rhs) {
+    return lhs.first < rhs.first;
+  });
+  names.erase(std::unique(names.begin(), names.end(), [](const NameType& lhs, const NameType& rhs) {
+    return lhs.first == rhs.first;
+  }), names.end());
+
+  nodes_.emplace_back();
+  BuildNode(0, names, 0);
+  nodes_view_ = nodes_;
+  edges_view_ = edges_;
+};
+
+void NameTrie::Assign(std::span<const Node> nodes, std::span<const Edge> edges) {
+  Clear();
+  nodes_view_ = nodes;
+  edges_view_ = edges;
+};
+
+void NameTrie::Clear() {
+  nodes_.clear();
+  edges_.clear();
+  nodes_view_ = {};
+  edges_view_ = {};
+};
+
+// names are sorted and share prefix of depth length
+void NameTrie::BuildNode(std::uint32_t node_ind, std::span<const NameType> names, std::size_t depth) {
+  if (names.empty())
+    return;
+
+  nodes_[node_ind].unique_slot = names.size() == 1 ? names.front().second : kAmbiguous;
+  if (names.front().first.size() == depth) {
+    nodes_[node_ind].slot = names.front().second;
+    names = names.subspan(1);
+  }
+
+  // edges of the node are reserved before children, so they stay contiguous
+  std::vector<std::span<const NameType>> groups;
+  for (std::size_t begin = 0; begin < names.size();) {
+    char symbol = names[begin].first[depth];
+    std::size_t end = begin + 1;
+    while (end < names.size() && names[end].first[depth] == symbol) {
+      ++end;
+    }
+    groups.push_back(names.subspan(begin, end - begin));
+    begin = end;
+  }
+
+  nodes_[node_ind].edges_begin = static_cast<std::uint32_t>(edges_.size());
+  nodes_[node_ind].edges_count = static_cast<std::uint32_t>(groups.size());
+  for (auto&& group : groups) {
+    edges_.push_back({group.front().first[depth], static_cast<std::uint32_t>(nodes_.size())});
+    nodes_.emplace_back();
+  }
+
+  for (std::size_t group_ind = 0; group_ind < groups.size(); ++group_ind) {
+    BuildNode(edges_[nodes_[node_ind].edges_begin + group_ind].child, groups[group_ind], depth + 1);
+  }
+};
+
+std::uint32_t NameTrie::Walk(std::string_view prefix, std::uint32_t node_ind) const {
+  if (nodes_view_.empty())
+    return kNotFound;
+
+  for (char symbol : prefix) {
+    const auto& node = nodes_view_[node_ind];
+    auto edges_begin = edges_view_.begin() + node.edges_begin;
+    auto edges_end = edges_begin + node.edges_count;
+    auto edge_itr = std::lower_bound(edges_begin, edges_end, symbol, [](const Edge& edge, char symbol) {
+      return edge.symbol < symbol;
+    });
+    if (edge_itr == edges_end || edge_itr->symbol != symbol)
+      return kNotFound;
+    node_ind = edge_itr->child;
+  }
+  return node_ind;
+};
+
+NameTrie::SlotType NameTrie::Find(std::string_view name) const {
+  auto node_ind = Walk(name);
+  return node_ind == kNotFound ? kNotFound : nodes_view_[node_ind].slot;
+};
+
+NameTrie::SlotType NameTrie::Find(std::string_view section, std::string_view name) const {
+  auto node_ind = Walk(section);
+  if (node_ind != kNotFound)
+    node_ind = Walk(".", node_ind);
+  if (node_ind != kNotFound)
+    node_ind = Walk(name, node_ind);
+  return node_ind == kNotFound ? kNotFound : nodes_view_[node_ind].slot;
+};
+
+NameTrie::SlotType NameTrie::FindPrefix(std::string_view prefix) const {
+  auto node_ind = Walk(prefix);
+  if (node_ind == kNotFound)
+    return kNotFound;
+  const auto& node = nodes_view_[node_ind];
+  return node.slot != kNotFound ? node.slot : node.unique_slot;
+};
+
+void NameTrie::Complete(std::string_view prefix, std::vector<SlotType>& slots) const {
+  if (auto node_ind = Walk(prefix); node_ind != kNotFound)
+    CollectSlots(node_ind, slots);
+};
+
+void NameTrie::CollectSlots(std::uint32_t node_ind, std::vector<SlotType>& slots) const {
+  const auto& node = nodes_view_[node_ind];
+  if (node.slot != kNotFound)
+    slots.push_back(node.slot);
+  for (std::uint32_t edge_ind = node.edges_begin; edge_ind < node.edges_begin + node.edges_count; ++edge_ind) {
+    CollectSlots(edges_view_[edge_ind].child, slots);
+  }
+};
+
+} // argument_parser
@@ -0,0 +1,75 @@
+#ifndef _TRIE_HPP_
+#define _TRIE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace argument_parser {
+
+// prefix tree over option names, nodes and edges are flat arrays:
+// edges of a node are contiguous and sorted, so walk is O(name length)
+class NameTrie {
+ public:
+  using SlotType = std::uint32_t;
+  using NameType = std::pair<std::string_view, SlotType>;
+
+  static constexpr SlotType kNotFound = std::numeric_limits<SlotType>::max();
+  static constexpr SlotType kAmbiguous = kNotFound - 1;
+
+  struct Node {
+    std::uint32_t edges_begin = 0;
+    std::uint32_t edges_count = 0;
+    SlotType slot = kNotFound;        // name which ends in the node
+    SlotType unique_slot = kNotFound; // the only name of the subtree or kAmbiguous
+  };
+
+  struct Edge {
+    char symbol;
+    std::uint32_t child;
+  };
+
+ public:
+  NameTrie() = default;
+  NameTrie(const NameTrie& value) = delete;
+  NameTrie(NameTrie&& value) = default;
+  NameTrie& operator=(NameTrie&& value) = default;
+
+  // the first of equal names is kept
+  void Build(std::vector<NameType> names);
+  // nodes and edges of built trie, e.g. mapped from schema cache; they must outlive the trie
+  void Assign(std::span<const Node> nodes, std::span<const Edge> edges);
+  void Clear();
+
+  SlotType Find(std::string_view name) const;
+  // name "section.name" without joining the parts
+  SlotType Find(std::string_view section, std::string_view name) const;
+  // exact name or the only name which starts with prefix, kAmbiguous if there are several
+  SlotType FindPrefix(std::string_view prefix) const;
+  // slots of all names starting with prefix in lexicographic order
+  void Complete(std::string_view prefix, std::vector<SlotType>& slots) const;
+
+  inline bool Empty() const { return nodes_view_.empty(); };
+  inline std::span<const Node> GetNodes() const { return nodes_view_; };
+  inline std::span<const Edge> GetEdges() const { return edges_view_; };
+
+ private:
+  void BuildNode(std::uint32_t node_ind, std::span<const NameType> names, std::size_t depth);
+  std::uint32_t Walk(std::string_view prefix, std::uint32_t node_ind = 0) const;
+  void CollectSlots(std::uint32_t node_ind, std::vector<SlotType>& slots) const;
+
+ private:
+  std::vector<Node> nodes_;
+  std::vector<Edge> edges_;
+  // built or assigned arrays, all lookups go through them
+  std::span<const Node> nodes_view_;
+  std::span<const Edge> edges_view_;
+};
+
+} // argument_parser
+
+#endif // _TRIE_HPP_
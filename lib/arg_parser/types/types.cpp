@@ -0,0 +1,136 @@
+#include "types.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace argument_parser {
+
+namespace {
+
+struct UnitType {
+  std::string_view name;
+  std::uint64_t factor;
+};
+
+// integer part and fraction in [0, 1), nothing is allocated
+bool ParseNumber(std::string_view& str_data, std::uint64_t& integer, double& fraction) {
+  auto begin = str_data.data();
+  auto end = str_data.data() + str_data.size();
+
+  auto [ptr, ec] = std::from_chars(begin, end, integer);
+  if (ec != std::errc())
+    return false;
+
+  fraction = 0;
+  if (ptr != end && *ptr == '.') {
+    double scale = 0.1;
+    for (++ptr; ptr != end && *ptr >= '0' && *ptr <= '9'; ++ptr, scale /= 10) {
+      fraction += (*ptr - '0') * scale;
+    }
+  }
+
+  str_data.remove_prefix(ptr - begin);
+  return true;
+};
+
+bool EqualIgnoreCase(std::string_view lhs, std::string_view rhs) {
+  if (lhs.size() != rhs.size())
+    return false;
+  for (std::size_t ind = 0; ind < lhs.size(); ++ind) {
+    auto lower = [](char symbol) { return symbol >= 'A' && symbol <= 'Z' ? symbol - 'A' + 'a' : symbol; };
+    if (lower(lhs[ind]) != lower(rhs[ind]))
+      return false;
+  }
+  return true;
+};
+
+bool Scale(std::uint64_t integer, double fraction, std::uint64_t factor, std::uint64_t& result) {
+  if (integer > std::numeric_limits<std::uint64_t>::max() / factor)
+    return false;
+  result = integer * factor;
+
+  auto fraction_part = static_cast<std::uint64_t>(fraction * factor);
+  if (result > std::numeric_limits<std::uint64_t>::max() - fraction_part)
+    return false;
+  result += fraction_part;
+  return true;
+};
+
+} // namespace
+
+bool ParseDuration(std::string_view str_data, Duration& value) {
+  // two symbol units go first, "ms" must not be read as "m"
+  constexpr UnitType units[] = {
+    {"ns", 1},
+    {"us", 1'000},
+    {"ms", 1'000'000},
+    {"s", 1'000'000'000},
+    {"m", 60'000'000'000},
+    {"h", 3'600'000'000'000},
+    {"d", 86'400'000'000'000},
+  };
+
+  if (str_data == "0") {
+    value.value = std::chrono::nanoseconds{0};
+    return true;
+  }
+  if (str_data.empty())
+    return false;
+
+  std::uint64_t total = 0;
+  while (!str_data.empty()) {
+    std::uint64_t integer = 0;
+    double fraction = 0;
+    if (!ParseNumber(str_data, integer, fraction))
+      return false;
+
+    const UnitType* unit = nullptr;
+    for (auto&& elem : units) {
+      if (str_data.starts_with(elem.name)) {
+        unit = &elem;
+        break;
+      }
+    }
+    if (!unit)
+      return false;
+    str_data.remove_prefix(unit->name.size());
+
+    std::uint64_t part = 0;
+    if (!Scale(integer, fraction, unit->factor, part) ||
+      total > std::numeric_limits<std::uint64_t>::max() - part)
+      return false;
+    total += part;
+  }
+
+  if (total > static_cast<std::uint64_t>(std::numeric_limits<std::chrono::nanoseconds::rep>::max()))
+    return false;
+
+  value.value = std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(total)};
+  return true;
+};
+
+bool ParseByteSize(std::string_view str_data, ByteSize& value) {
+  constexpr UnitType units[] = {
+    {"", 1}, {"B", 1},
+    {"K", 1ull << 10}, {"KiB", 1ull << 10}, {"KB", 1'000},
+    {"M", 1ull << 20}, {"MiB", 1ull << 20}, {"MB", 1'000'000},
+    {"G", 1ull << 30}, {"GiB", 1ull << 30}, {"GB", 1'000'000'000},
+    {"T", 1ull << 40}, {"TiB", 1ull << 40}, {"TB", 1'000'000'000'000},
+    {"P", 1ull << 50}, {"PiB", 1ull << 50}, {"PB", 1'000'000'000'000'000},
+  };
+
+  std::uint64_t integer = 0;
+  double fraction = 0;
+  if (!ParseNumber(str_data, integer, fraction))
+    return false;
+
+  for (auto&& unit : units) {
+    if (EqualIgnoreCase(str_data, unit.name))
+      return Scale(integer, fraction, unit.factor, value.value);
+  }
+  return false;
+};
+
+} // argument_parser
@@ -0,0 +1,169 @@
+#ifndef _TYPES_HPP_
+#define _TYPES_HPP_
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <lib/arg_parser/store/store.hpp>
+
+namespace argument_parser {
+
+// "250ms", "1.5s", "1h30m"; units: ns, us, ms, s, m, h, d
+struct Duration {
+  std::chrono::nanoseconds value{0};
+  bool operator==(const Duration& other) const = default;
+};
+
+// "4GiB", "512K", "100MB"; K, M, G, T, P are binary as KiB, KB is decimal
+struct ByteSize {
+  std::uint64_t value = 0;
+  bool operator==(const ByteSize& other) const = default;
+};
+
+bool ParseDuration(std::string_view str_data, Duration& value);
+bool ParseByteSize(std::string_view str_data, ByteSize& value);
+
+template<>
+struct Converter<Duration> {
+  static bool Convert(std::string_view str_data, Duration& value) {
+    return ParseDuration(str_data, value);
+  };
+  static std::string GetStrType() { return "duration: ns|us|ms|s|m|h|d"; };
+};
+
+template<>
+struct Converter<ByteSize> {
+  static bool Convert(std::string_view str_data, ByteSize& value) {
+    return ParseByteSize(str_data, value);
+  };
+  static std::string GetStrType() { return "bytes: B|K|KB|KiB|M|MB|MiB|G|GB|GiB|T|TB|TiB|P|PB|PiB"; };
+};
+
+// enum becomes choice argument by specialization
+//   template<> struct argument_parser::ChoiceTraits<Mode> {
+//     static constexpr std::array choices = {
+//       std::pair<std::string_view, Mode>{"mmap", Mode::kMmap}, ...
+//     };
+//   };
+template<typename EnumType>
+struct ChoiceTraits;
+
+template<typename EnumType>
+concept IsChoice = requires {
+  { ChoiceTraits<EnumType>::choices.size() } -> std::convertible_to<std::size_t>;
+};
+
+// table is built at compile time, so lookup is one hash and one compare
+template<typename EnumType, std::size_t Count>
+class PerfectHashTable {
+ public:
+  using ChoiceType = std::pair<std::string_view, EnumType>;
+  static constexpr std::size_t kSize = std::bit_ceil(Count * 2);
+
+ public:
+  template<typename ChoicesType>
+  consteval PerfectHashTable(const ChoicesType& choices);
+
+  constexpr bool Find(std::string_view name, EnumType& value) const;
+  constexpr const std::array<ChoiceType, Count>& GetChoices() const { return choices_; };
+
+ private:
+  static constexpr std::uint32_t Hash(std::string_view name, std::uint32_t seed);
+
+ private:
+  std::array<ChoiceType, Count> choices_{};
+  std::array<std::size_t, kSize> slots_{};
+  std::uint32_t seed_ = 0;
+};
+
+template<typename EnumType, std::size_t Count>
+template<typename ChoicesType>
+consteval PerfectHashTable<EnumType, Count>::PerfectHashTable(const ChoicesType& choices) {
+  static_assert(Count > 0, "\nPerfectHashTable\n   choice list must not be empty\n");
+
+  for (std::size_t ind = 0; ind < Count; ++ind) {
+    choices_[ind] = {std::string_view(choices[ind].first), choices[ind].second};
+    for (std::size_t prev_ind = 0; prev_ind < ind; ++prev_ind) {
+      if (choices_[prev_ind].first == choices_[ind].first)
+        throw std::logic_error("PerfectHashTable: choice names must be unique");
+    }
+  }
+
+  constexpr std::uint32_t max_seed = 1 << 16;
+  for (; seed_ < max_seed; ++seed_) {
+    slots_.fill(Count);
+
+    bool is_collision = false;
+    for (std::size_t ind = 0; ind < Count && !is_collision; ++ind) {
+      auto& slot = slots_[Hash(choices_[ind].first, seed_) & (kSize - 1)];
+      is_collision = slot != Count;
+      slot = ind;
+    }
+
+    if (!is_collision)
+      return;
+  }
+
+  throw std::logic_error("PerfectHashTable: perfect hash seed is not found");
+};
+
+template<typename EnumType, std::size_t Count>
+constexpr bool PerfectHashTable<EnumType, Count>::Find(std::string_view name, EnumType& value) const {
+  auto ind = slots_[Hash(name, seed_) & (kSize - 1)];
+  if (ind == Count || choices_[ind].first != name)
+    return false;
+
+  value = choices_[ind].second;
+  return true;
+};
+
+template<typename EnumType, std::size_t Count>
+constexpr std::uint32_t PerfectHashTable<EnumType, Count>::Hash(std::string_view name, std::uint32_t seed) {
+  std::uint32_t hash = 2166136261u ^ (seed * 16777619u);
+  for (char symbol : name) {
+    hash ^= static_cast<unsigned char>(symbol);
+    hash *= 16777619u;
+  }
+  return hash ^ (hash >> 15);
+};
+
+template<IsChoice EnumType>
+inline constexpr PerfectHashTable<EnumType, ChoiceTraits<EnumType>::choices.size()>
+  kChoiceTable{ChoiceTraits<EnumType>::choices};
+
+template<IsChoice EnumType>
+struct Converter<EnumType> {
+  static bool Convert(std::string_view str_data, EnumType& value) {
+    return kChoiceTable<EnumType>.Find(str_data, value);
+  };
+  static std::string GetStrType();
+  static void GetChoices(std::vector<std::string_view>& choices) {
+    for (auto&& [name, value] : kChoiceTable<EnumType>.GetChoices()) {
+      choices.push_back(name);
+    }
+  };
+};
+
+template<IsChoice EnumType>
+std::string Converter<EnumType>::GetStrType() {
+  std::string str_type;
+  for (auto&& [name, value] : kChoiceTable<EnumType>.GetChoices()) {
+    if (!str_type.empty())
+      str_type += '|';
+    str_type += name;
+  }
+  return str_type;
+};
+
+} // argument_parser
+
+#endif // _TYPES_HPP_
@@ -0,0 +1,103 @@
+#include "validator.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include <iostream>
+
+#include <lib/arg_parser/profile/allocation.hpp>
+
+namespace argument_parser {
+
+void ArgumentBitset::Resize(std::size_t size) {
+  words_.resize((size + kWordBits - 1) / kWordBits, 0);
+  size_ = size;
+};
+
+void ArgumentBitset::Clear() {
+  std::fill(words_.begin(), words_.end(), 0);
+};
+
+void ValidatorDevice::Registrate(const Argument& arg) {
+  std::size_t ind = required_.Size();
+
+  required_.Resize(ind + 1);
+  found_.Resize(ind + 1);
+  initialized_.Resize(ind + 1);
+
+  if (arg.GetStatus() == Argument::FoundClasses::NOT_FOUND)
+    required_.Set(ind);
+
+#ifdef LABA4
+  if (arg.IsMultivalue() && arg.min_val > 0)
+    min_counts_.emplace_back(ind, arg.min_val);
+#endif
+};
+
+void ValidatorDevice::Clear() {
+  required_ = {};
+  found_ = {};
+  initialized_ = {};
+  min_counts_.clear();
+};
+
+void ValidatorDevice::Begin() {
+  found_.Clear();
+  initialized_.Clear();
+};
+
+void ValidatorDevice::Mark(std::size_t ind, Argument::FoundClasses status) {
+  if (status == Argument::FoundClasses::WAS_FOUND) {
+    found_.Set(ind);
+  } else if (status == Argument::FoundClasses::WAS_INITIALIZE) {
+    initialized_.Set(ind);
+  }
+};
+
+void ValidatorDevice::Run(std::vector<Argument>& args) const {
+  allocation::PhaseScope validation_phase(allocation::Phase::VALIDATION);
+  decltype(auto) required_words = required_.GetWords();
+  decltype(auto) found_words = found_.GetWords();
+  decltype(auto) initialized_words = initialized_.GetWords();
+
+  for (std::size_t word_ind = 0; word_ind < required_words.size(); ++word_ind) {
+    if (auto missing = required_words[word_ind] &
+      ~(found_words[word_ind] | initialized_words[word_ind]); missing) {
+      auto& arg = args[word_ind * ArgumentBitset::kWordBits + std::countr_zero(missing)];
+      allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+      std::string error_message = "parse fail, cannot find arg\n   full name: ";
+      error_message += arg.GetFullName();
+      error_message += "\n   short name: ";
+      error_message += arg.GetShortName();
+      throw std::runtime_error(error_message);
+    }
+  }
+
+#ifdef PARSER_VERBOSE
+  for (std::size_t word_ind = 0; word_ind < found_words.size(); ++word_ind) {
+    for (auto uninitialized = found_words[word_ind] & ~initialized_words[word_ind];
+      uninitialized; uninitialized &= uninitialized - 1) {
+      auto& arg = args[word_ind * ArgumentBitset::kWordBits + std::countr_zero(uninitialized)];
+      std::cerr << "Arg was not initialized:\n"
+        << "   full name: " << arg.GetFullName() << "\n"
+        << "   short name: " << arg.GetShortName() << std::endl;
+    }
+  }
+#endif
+
+#ifdef LABA4
+  for (auto&& [ind, min_count] : min_counts_) {
+    if (min_count > args[ind].GetStoreCount()) {
+      allocation::PhaseScope error_phase(allocation::Phase::ERROR);
+      std::string error_message = "parse fail, minimal count of multivalue not found arg\n   full name: ";
+      error_message += args[ind].GetFullName();
+      error_message += "\n   short name: ";
+      error_message += args[ind].GetShortName();
+      throw std::runtime_error(error_message);
+    }
+  }
+#endif // LABA4
+};
+
+} // argument_parser
@@ -0,0 +1,56 @@
+#ifndef _VALIDATOR_HPP_
+#define _VALIDATOR_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <lib/arg_parser/argument/argument.hpp>
+
+namespace argument_parser {
+
+class ArgumentBitset {
+ public:
+  using WordType = std::uint64_t;
+  static constexpr std::size_t kWordBits = sizeof(WordType) * 8;
+
+ public:
+  void Resize(std::size_t size);
+  void Clear();
+
+  inline std::size_t Size() const { return size_; };
+  inline void Set(std::size_t ind) { words_[ind / kWordBits] |= WordType{1} << (ind % kWordBits); };
+  inline bool Test(std::size_t ind) const {
+    return words_[ind / kWordBits] & (WordType{1} << (ind % kWordBits));
+  };
+
+  inline const std::vector<WordType>& GetWords() const { return words_; };
+
+ private:
+  std::vector<WordType> words_;
+  std::size_t size_ = 0;
+};
+
+// Schema part (required bits, minimal counts) is filled once on registration,
+// parse part (found / initialized bits) is refilled by ParserDevice on every run
+class ValidatorDevice {
+ public:
+  void Registrate(const Argument& arg);
+  void Clear();
+
+  void Begin();
+  void Mark(std::size_t ind, Argument::FoundClasses status);
+  void Run(std::vector<Argument>& args) const;
+
+ private:
+  ArgumentBitset required_;
+  ArgumentBitset found_;
+  ArgumentBitset initialized_;
+
+  std::vector<std::pair<std::size_t, std::size_t>> min_counts_;
+};
+
+} // argument_parser
+
+#endif // _VALIDATOR_HPP_
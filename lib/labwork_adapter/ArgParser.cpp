@@ -5,11 +5,13 @@
 #include <vector>
 #include <string_view>
 #include <algorithm>
+#include <stdexcept>
 
 #include <argument.hpp>
 
 namespace ArgumentParser {
-ArgumentLabwork::ArgumentLabwork(argument_parser::Argument arg) : arg_(std::move(arg)) {  };
+ArgumentLabwork::ArgumentLabwork(argument_parser::Argument arg, std::size_t slot)
+  : arg_(std::move(arg)), slot_(slot) {  };
 
 ArgParserLabwork::ArgParserLabwork(std::string_view parser_name) : parser_name_(parser_name) {  };
 
@@ -32,7 +34,7 @@ ArgumentLabwork& ArgParserLabwork::AddIntArgument(char short_name, std::string_v
 
   arg.SetStore(new argument_parser::Store<int>{});
 
-  argument_labwork_cont_.emplace_back(std::move(arg));
+  argument_labwork_cont_.emplace_back(std::move(arg), argument_labwork_cont_.size());
 
   return argument_labwork_cont_.back();
 };
@@ -54,7 +56,7 @@ ArgumentLabwork& ArgParserLabwork::AddStringArgument(char short_name, std::strin
   short_name_cont_.emplace_back(new char[2]{short_name, '\0'});
   argument_parser::Argument arg{full_name, short_name_cont_.back().get(), descriprion};  arg.SetStore(new argument_parser::Store<std::string>{});
 
-  argument_labwork_cont_.emplace_back(std::move(arg));
+  argument_labwork_cont_.emplace_back(std::move(arg), argument_labwork_cont_.size());
 
   return argument_labwork_cont_.back();
 };
@@ -74,7 +76,7 @@ ArgumentLabwork& ArgParserLabwork::AddFlag(char short_name, std::string_view ful
 ArgumentLabwork& ArgParserLabwork::AddFlag(char short_name, std::string_view full_name, std::string_view descriprion) {
   short_name_cont_.emplace_back(new char[2]{short_name, '\0'});
   argument_parser::Argument arg{full_name, short_name_cont_.back().get(), descriprion};  arg.SetStore(new argument_parser::Store<bool>{});
-  argument_labwork_cont_.emplace_back(std::move(arg));
+  argument_labwork_cont_.emplace_back(std::move(arg), argument_labwork_cont_.size());
 
   return argument_labwork_cont_.back();
 };
@@ -96,7 +98,8 @@ void ArgParserLabwork::AddHelp(char short_name, std::string_view full_name, std:
   argument_parser::Argument arg{full_name, short_name_cont_.back().get(), descriprion};  arg.SetStore(new argument_parser::Store<bool>{});
   arg.WasFound();
 
-  argument_labwork_cont_.emplace_back(std::move(arg));
+  help_ind_ = argument_labwork_cont_.size();
+  argument_labwork_cont_.emplace_back(std::move(arg), argument_labwork_cont_.size());
 
   help_name_ = full_name;
 };
@@ -108,39 +111,124 @@ bool ArgParserLabwork::Help() {
 };
 
 std::string ArgParserLabwork::HelpDescription() {
-  std::string full_description{parser_name_.begin(), parser_name_.end()};
-  full_description += "\n";
-  full_description += arg_parser_device_.GetDescriptions();
+  std::size_t help_size = arg_parser_device_.WriteHelp(std::span<char>{});
+  std::string full_description;
+  full_description.reserve(parser_name_.size() + 1 + help_size);
+  full_description += parser_name_;
+  full_description += '\n';
+  full_description.resize(full_description.size() + help_size);
+  arg_parser_device_.WriteHelp(std::span<char>(full_description).last(help_size));
   return full_description;
 };
 
-bool ArgParserLabwork::Parse(int argc, char** argv) {
-  std::vector<std::string> argv_cont;
+void ArgParserLabwork::WriteHelp(std::ostream& stream) {
+  stream << parser_name_ << '\n';
+  arg_parser_device_.WriteHelp(stream);
+};
+
+void ArgParserLabwork::RegistrateArguments() {
+  // arguments are moved into the parser once, so slots stay the same between Parse calls
+  for (std::size_t ind = slot_cont_.size(); ind < argument_labwork_cont_.size(); ++ind) {
+    slot_cont_.push_back(arg_parser_device_.registrate_slot(argument_labwork_cont_[ind].GetArg()));
+  }
+  if (help_ind_ < slot_cont_.size())
+    arg_parser_device_.SetHelpSlot(slot_cont_[help_ind_]);
+};
 
-  std::for_each(argv, argv + argc, [&argv_cont](char* elem){
-    argv_cont.emplace_back(elem);
-  });
+template<typename RangeType>
+bool ArgParserLabwork::ParseRange(RangeType&& argv) {
+  RegistrateArguments();
+  auto parse_res = arg_parser_device_.parse(std::forward<RangeType>(argv));
 
-  return Parse(argv_cont);
+  if (arg_parser_device_.GetParseStatus() == argument_parser::ParseStatus::HELP_REQUESTED || Help()) {
+    WriteHelp(std::cout);
+    std::cout << std::endl;
+    return true;
+  }
+  return parse_res;
+};
+
+bool ArgParserLabwork::Parse(int argc, char** argv) {
+  // argv is lexed in place, nothing is copied
+  std::span<char*> argv_cont;
+  if (argc > 0) {
+    argv_cont = {argv + 1, argv + argc};
+  }
+
+  return ParseRange(argv_cont);
 };
 
 bool ArgParserLabwork::Parse(const std::vector<std::string>& argv) {
-  for (auto&& arg : argument_labwork_cont_) {
-    arg_parser_device_.registrate(arg.GetArg());
+  std::span<const std::string> argv_cont;
+  if (!argv.empty()) {
+    argv_cont = {std::begin(argv) + 1, std::end(argv)};
   }
 
-  std::vector<std::string_view> argv_sv_cont;
-  std::for_each(std::begin(argv) + 1, std::end(argv), [&argv_sv_cont](const std::string& elem){
-    argv_sv_cont.emplace_back(elem);
-  });
+  return ParseRange(argv_cont);
+};
 
-  auto parse_res = arg_parser_device_.parse(argv_sv_cont);
+bool ArgParserLabwork::ParseCommandLine(std::string_view command_line) {
+  try {
+    tokenizer_.Run(command_line);
+  } catch (std::runtime_error& ex){
+#ifdef PARSER_VERBOSE
+    std::cerr << ex.what() << std::endl;
+#endif
+    return false;
+  }
 
-  if (Help()) {
-    std::cout << HelpDescription() << std::endl;
-    return true;
+  std::span<const std::string_view> argv_cont = tokenizer_.GetTokens();
+  if (!argv_cont.empty()) {
+    argv_cont = argv_cont.subspan(1);
   }
-  return parse_res;
+
+  return ParseRange(argv_cont);
+};
+
+std::span<const std::string_view> ArgParserLabwork::GetPassThrough() const {
+  return arg_parser_device_.GetPassThrough();
+};
+
+void ArgParserLabwork::SetStrict(bool is_strict) {
+  arg_parser_device_.SetStrict(is_strict);
+};
+
+const std::vector<std::string_view>& ArgParserLabwork::GetUnknown() const {
+  return arg_parser_device_.GetUnknown();
+};
+
+void ArgParserLabwork::SetEnvironmentSource(char** environment) {
+  arg_parser_device_.SetEnvironmentSource(environment);
+};
+
+bool ArgParserLabwork::LoadConfig(const std::string& path) {
+  return arg_parser_device_.LoadConfig(path);
+};
+
+bool ArgParserLabwork::SetConfig(std::string_view text) {
+  return arg_parser_device_.SetConfig(text);
+};
+
+void ArgParserLabwork::SetParallelThreshold(std::size_t threshold) {
+  arg_parser_device_.SetParallelThreshold(threshold);
+};
+
+void ArgParserLabwork::Reset() {
+  arg_parser_device_.Reset();
+};
+
+void ArgParserLabwork::SetAbbreviation(bool is_abbreviation) {
+  arg_parser_device_.SetAbbreviation(is_abbreviation);
+};
+
+std::vector<std::string_view> ArgParserLabwork::Complete(std::string_view prefix) {
+  RegistrateArguments();
+  return arg_parser_device_.Complete(prefix);
+};
+
+std::vector<std::string> ArgParserLabwork::Complete(std::string_view command_line, std::size_t cursor) {
+  RegistrateArguments();
+  return arg_parser_device_.CompleteLine(command_line, cursor);
 };
 
 bool ArgParserLabwork::GetFlag(std::string_view name) {
@@ -1,25 +1,34 @@
 #ifndef _ARG_PARSER_LABWORK4_HPP_
 #define _ARG_PARSER_LABWORK4_HPP_
 
+#include <span>
 #include <string_view>
 #include <memory>
+#include <ostream>
 #include <type_traits>
 
 #include <lib/arg_parser/arg_parser.hpp>
 #include <lib/arg_parser/argument/argument.hpp>
 #include <lib/arg_parser/store/store.hpp>
+#include <lib/arg_parser/tokenizer/tokenizer.hpp>
 
 namespace ArgumentParser {
 
 class ArgumentLabwork {
  public:
-  ArgumentLabwork(argument_parser::Argument arg);
-  ArgumentLabwork(ArgumentLabwork&& value) : arg_(std::move(value.arg_)) {  };
+  ArgumentLabwork(argument_parser::Argument arg, std::size_t slot);
+  ArgumentLabwork(ArgumentLabwork&& value) : arg_(std::move(value.arg_)), slot_(value.slot_) {  };
   ArgumentLabwork& operator=(ArgumentLabwork&& value) {
     arg_ = std::move(value.arg_);
+    slot_ = value.slot_;
     return *this;
   };
 
+  // ArgHandle<int> count = parser.AddIntArgument("count");
+  // handle of other value type than the store has is invalid
+  template<typename Type>
+  operator argument_parser::ArgHandle<Type>() const;
+
   template<typename Type>
   ArgumentLabwork& StoreValue(Type& store_ptr);
 
@@ -28,7 +37,21 @@ class ArgumentLabwork {
 
   template<typename Type>
   ArgumentLabwork& MultiValue(int count = 0);
+
+  // "key=value" items collected into sorted FlatMap, "--define a=b -D=c=d"
+  template<typename KeyType = std::string, typename ValueType = std::string>
+  ArgumentLabwork& Map(int count = 0);
+
+  // counts occurrences of the option, "-vvv" gives 3
+  template<typename Type = int>
+  ArgumentLabwork& Counter();
+
+  // folds all values of the option by Reducer (argument_parser::reduce::Sum, Max, Last)
+  template<typename Type, typename Reducer>
+  ArgumentLabwork& Reduce();
   inline ArgumentLabwork& Positional() { arg_.Positional(); return *this; };
+  // value of the variable is taken when the option is not in command line
+  inline ArgumentLabwork& Environment(std::string_view name) { arg_.SetEnvironment(name); return *this; };
 
   template<typename Type>
   ArgumentLabwork& Default(Type&& default_value);
@@ -36,6 +59,14 @@ class ArgumentLabwork {
   inline argument_parser::Argument GetArg() { return std::move(arg_); };
  private:
   argument_parser::Argument arg_;
+  std::size_t slot_;
+};
+
+template<typename Type>
+ArgumentLabwork::operator argument_parser::ArgHandle<Type>() const {
+  if (!arg_.IsHolding<Type>())
+    return {};
+  return argument_parser::ArgHandle<Type>(slot_);
 };
 
 template<typename Type>
@@ -48,7 +79,9 @@ ArgumentLabwork& ArgumentLabwork::Default(Type&& default_value) {
 
 template<typename Type>
 ArgumentLabwork& ArgumentLabwork::StoreValue(Type& store_ptr) {
-  arg_.SetStore(new argument_parser::Store<std::remove_reference_t<Type>>());
+  if (!dynamic_cast<const argument_parser::Store<std::remove_reference_t<Type>>*>(arg_.GetStorePtr())) {
+    arg_.SetStore(new argument_parser::Store<std::remove_reference_t<Type>>());
+  }
   arg_.SetPtrStore(&store_ptr);
   return *this;
 }
@@ -66,6 +99,27 @@ ArgumentLabwork& ArgumentLabwork::MultiValue(int count) {
   return *this;
 };
 
+template<typename KeyType, typename ValueType>
+ArgumentLabwork& ArgumentLabwork::Map(int count) {
+  arg_.SetMultiValueStore(
+    new argument_parser::MultiValueStore<argument_parser::FlatMap<KeyType, ValueType>>()).min_val = count;
+  return *this;
+};
+
+template<typename Type>
+ArgumentLabwork& ArgumentLabwork::Counter() {
+  arg_.SetStore(new argument_parser::CounterStore<Type>());
+  arg_.WasFound();
+  return *this;
+};
+
+template<typename Type, typename Reducer>
+ArgumentLabwork& ArgumentLabwork::Reduce() {
+  arg_.SetStore(new argument_parser::ReduceStore<Type, Reducer>());
+  arg_.WasFound();
+  return *this;
+};
+
 class ArgParserLabwork {
  public:
   ArgParserLabwork(std::string_view parser_name);
@@ -94,28 +148,137 @@ class ArgParserLabwork {
   ArgumentLabwork& AddFlag(char short_name, std::string_view full_name, std::string_view descriprion);
   bool GetFlag(std::string_view name);
 
+  // any type with argument_parser::Converter, e.g. Duration, ByteSize or choice enum
+  template<typename Type>
+  ArgumentLabwork& AddArgument(std::string_view full_name, std::string_view descriprion = "");
+  template<typename Type>
+  ArgumentLabwork& AddArgument(char short_name, std::string_view full_name, std::string_view descriprion = "");
+  template<typename Type>
+  Type GetValue(std::string_view name);
+  template<typename Type>
+  std::vector<Type> GetValues(std::string_view name);
+  template<typename KeyType = std::string, typename ValueType = std::string>
+  argument_parser::FlatMap<KeyType, ValueType> GetMap(std::string_view name);
+
+  // handle reads are one index, values are valid after Parse
+  template<typename Type>
+  const Type& GetValue(argument_parser::ArgHandle<Type> handle) const;
+  inline int GetIntValue(argument_parser::ArgHandle<int> handle) const { return GetValue(handle); };
+  inline const std::string& GetStringValue(argument_parser::ArgHandle<std::string> handle) const {
+    return GetValue(handle);
+  };
+  inline bool GetFlag(argument_parser::ArgHandle<bool> handle) const { return GetValue(handle); };
+
  public:
   void AddHelp(std::string_view full_name);
   void AddHelp(std::string_view full_name, std::string_view descriprion);
   void AddHelp(char short_name, std::string_view full_name);
   void AddHelp(char short_name, std::string_view full_name, std::string_view descriprion);
   bool Help();
+  // HELP_REQUESTED after Parse, which found help option before converting anything
+  inline argument_parser::ParseStatus GetParseStatus() const { return arg_parser_device_.GetParseStatus(); };
   std::string HelpDescription();
+  // laid out help is written without building the string
+  void WriteHelp(std::ostream& stream);
 
  public:
   bool Parse(int argc, char** argv);
   bool Parse(const std::vector<std::string>& argv);
+  // whole command line with program name, split by shell rules; must outlive the results
+  bool ParseCommandLine(std::string_view command_line);
+
+  // points into argv of the last Parse, so it is valid while that argv is alive
+  std::span<const std::string_view> GetPassThrough() const;
+
+  // not strict parser collects unknown options instead of fail
+  void SetStrict(bool is_strict);
+  const std::vector<std::string_view>& GetUnknown() const;
+
+  // "NAME=value" array ended by nullptr which Environment variables are read from,
+  // nullptr is environ of the process
+  void SetEnvironmentSource(char** environment);
+
+  // "key = value" file, options of command line and environment override it
+  bool LoadConfig(const std::string& path);
+  // text of config must outlive the results
+  bool SetConfig(std::string_view text);
+
+  // positional value lists not shorter than threshold are converted in parallel
+  void SetParallelThreshold(std::size_t threshold);
+
+  // values of the last Parse are read as defaults, every Parse starts from defaults too
+  void Reset();
+
+  // unique prefix of full name is accepted, "--verb" for "--verbose"
+  void SetAbbreviation(bool is_abbreviation);
+  // full names starting with prefix in lexicographic order
+  std::vector<std::string_view> Complete(std::string_view prefix);
+  // candidates for the word under cursor of partial command line with program name:
+  // options, choice values and subcommands, the line is not parsed
+  std::vector<std::string> Complete(std::string_view command_line, std::size_t cursor);
+ private:
+  void RegistrateArguments();
+  template<typename RangeType>
+  bool ParseRange(RangeType&& argv);
+
  private:
   std::string_view help_name_;
+  // index of help argument in argument_labwork_cont_
+  std::size_t help_ind_ = argument_parser::ArgParser::kNoHelp;
+  argument_parser::TokenizerDevice tokenizer_;
 
   argument_parser::ArgParser arg_parser_device_;
 
   std::vector<ArgumentLabwork> argument_labwork_cont_;
+  // parser slot of every added argument, filled by the first Parse after adding
+  std::vector<std::size_t> slot_cont_;
   std::vector<std::unique_ptr<char>> short_name_cont_;
 
   std::string_view parser_name_;
 };
 
+template<typename Type>
+ArgumentLabwork& ArgParserLabwork::AddArgument(std::string_view full_name, std::string_view descriprion) {
+  return AddArgument<Type>('\0', full_name, descriprion);
+};
+
+template<typename Type>
+ArgumentLabwork& ArgParserLabwork::AddArgument(char short_name, std::string_view full_name,
+  std::string_view descriprion) {
+  short_name_cont_.emplace_back(new char[2]{short_name, '\0'});
+  argument_parser::Argument arg{full_name, short_name_cont_.back().get(), descriprion};
+  arg.SetStore(new argument_parser::Store<Type>{});
+
+  argument_labwork_cont_.emplace_back(std::move(arg), argument_labwork_cont_.size());
+
+  return argument_labwork_cont_.back();
+};
+
+template<typename Type>
+Type ArgParserLabwork::GetValue(std::string_view name) {
+  return arg_parser_device_.GetValue<Type>(name);
+};
+
+template<typename Type>
+std::vector<Type> ArgParserLabwork::GetValues(std::string_view name) {
+  return arg_parser_device_.GetMultiValue<std::vector<Type>>(name);
+};
+
+template<typename Type>
+const Type& ArgParserLabwork::GetValue(argument_parser::ArgHandle<Type> handle) const {
+  static const Type kEmpty{};
+  // argument of the same names and other type is not registrated
+  if (!handle.IsValid() || handle.GetSlot() >= slot_cont_.size() ||
+      slot_cont_[handle.GetSlot()] == argument_parser::ArgParser::kNoSlot)
+    return kEmpty;
+  return arg_parser_device_.GetValue(argument_parser::ArgHandle<Type>(slot_cont_[handle.GetSlot()]));
+};
+
+template<typename KeyType, typename ValueType>
+argument_parser::FlatMap<KeyType, ValueType> ArgParserLabwork::GetMap(std::string_view name) {
+  return arg_parser_device_.GetMultiValue<argument_parser::FlatMap<KeyType, ValueType>>(name);
+};
+
 } // ArgumentParser
 
 #endif // _ARG_PARSER_LABWORK4_HPP_
\ No newline at end of file
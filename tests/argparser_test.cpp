@@ -1,8 +1,16 @@
 #include "lib/arg_parser/store/store.hpp"
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <ranges>
 #include <sstream>
+#include <thread>
 
 #include <gtest/gtest.h>
 #include <lib/labwork_adapter/ArgParser.hpp>
+#include <lib/arg_parser/types/types.hpp>
+#include <lib/arg_parser/binding/binding.hpp>
+#include <lib/arg_parser/profile/allocation_hook.hpp>
 
 using namespace ArgumentParser;
 
@@ -462,4 +470,1177 @@ ASSERT_FALSE(parser_device.parse(argv_test3));
         std::cout << "main:   PARSING FAIL" << std::endl;
     }
 #endif
-}
\ No newline at end of file
+}
+TEST(ArgParserTestSuite, ManyOptionalOneRequired) {
+    std::vector<std::string> names;
+    for (std::size_t ind = 0; ind < 150; ++ind) {
+        names.push_back("flag" + std::to_string(ind));
+    }
+
+    auto make_parser = [&names](ArgParserLabwork& parser) {
+        for (auto&& name : names) {
+            parser.AddFlag(name);
+        }
+        parser.AddIntArgument("required", "required after the first bitset words");
+        parser.AddIntArgument('m', "multi", "multivalue with minimal count").MultiValue<int>(2);
+    };
+
+    ArgParserLabwork no_required_parser("TestParser");
+    make_parser(no_required_parser);
+    ASSERT_FALSE(no_required_parser.Parse(SplitString("app --flag70 -m 1 -m 2")));
+
+    ArgParserLabwork min_count_parser("TestParser");
+    make_parser(min_count_parser);
+    ASSERT_FALSE(min_count_parser.Parse(SplitString("app --required=1 -m 1")));
+
+    ArgParserLabwork parser("TestParser");
+    make_parser(parser);
+    ASSERT_TRUE(parser.Parse(SplitString("app --required=1 -m 1 -m 2 --flag149")));
+    ASSERT_TRUE(parser.GetFlag("flag149"));
+    ASSERT_FALSE(parser.GetFlag("flag70"));
+    ASSERT_EQ(parser.GetIntValue("required"), 1);
+}
+
+TEST(ArgParserTestSuite, PassThroughAfterTerminator) {
+    std::vector<std::string> argv = SplitString("app --number=3 -- --not_registered KEY=VAL -- tail");
+
+    ArgParserLabwork parser("TestParser");
+    parser.AddIntArgument("number");
+
+    ASSERT_TRUE(parser.Parse(argv));
+    ASSERT_EQ(parser.GetIntValue("number"), 3);
+
+    auto pass_through = parser.GetPassThrough();
+    const char* correct_arr[] = {"--not_registered", "KEY=VAL", "--", "tail"};
+
+    ASSERT_EQ(pass_through.size(), sizeof(correct_arr) / sizeof(correct_arr[0]));
+    for (std::size_t ind = 0; ind < pass_through.size(); ++ind) {
+        ASSERT_EQ(pass_through[ind], correct_arr[ind]);
+        ASSERT_EQ(pass_through[ind].data(), argv[ind + 3].data());
+    }
+}
+
+TEST(ArgParserTestSuite, UnknownCollection) {
+    std::vector<std::string> argv = SplitString("app --level=2 --threads=8 -x --mode=fast -v positional");
+
+    ArgParserLabwork launcher("Launcher");
+    launcher.SetStrict(false);
+    launcher.AddIntArgument("level");
+    launcher.AddFlag('v', "verbose");
+    launcher.AddStringArgument("input").Positional();
+
+    ASSERT_TRUE(launcher.Parse(argv));
+    ASSERT_EQ(launcher.GetIntValue("level"), 2);
+    ASSERT_TRUE(launcher.GetFlag("verbose"));
+    // glued value of unknown option goes with it, not to positional
+    ASSERT_EQ(launcher.GetStringValue("input"), "positional");
+
+    const char* correct_arr[] = {"--threads=8", "-x", "--mode=fast"};
+    auto&& unknown = launcher.GetUnknown();
+    ASSERT_EQ(unknown.size(), sizeof(correct_arr) / sizeof(correct_arr[0]));
+    for (std::size_t ind = 0; ind < unknown.size(); ++ind) {
+        ASSERT_EQ(unknown[ind], correct_arr[ind]);
+    }
+
+    ArgParserLabwork strict_launcher("Launcher");
+    strict_launcher.AddIntArgument("level");
+    ASSERT_FALSE(strict_launcher.Parse(SplitString("app --level=2 --threads=8")));
+
+    std::vector<std::string_view> worker_argv(unknown.begin(), unknown.end());
+    argument_parser::ArgParser worker;
+    worker.SetStrict(false);
+    worker.registrate(argument_parser::make_argument<int>("threads").SetStore(new argument_parser::Store<int>()));
+    ASSERT_TRUE(worker.parse(worker_argv));
+    ASSERT_EQ(worker.GetValue<int>("threads"), 8);
+    ASSERT_EQ(worker.GetUnknown(), (std::vector<std::string_view>{"-x", "--mode=fast"}));
+
+    // separate token after unknown option is positional, the option may be a flag
+    ASSERT_TRUE(launcher.Parse(SplitString("app --level=1 --unknown-flag input.txt")));
+    ASSERT_EQ(launcher.GetStringValue("input"), "input.txt");
+    ASSERT_EQ(launcher.GetUnknown(), (std::vector<std::string_view>{"--unknown-flag"}));
+}
+
+TEST(ArgParserTestSuite, CounterAndReduce) {
+    ArgParserLabwork parser("TestParser");
+    int verbosity = 0;
+    parser.AddIntArgument('v', "verbose").Counter().StoreValue(verbosity);
+    parser.AddIntArgument('q', "quiet").Counter();
+    parser.AddIntArgument('s', "sum").Reduce<int, argument_parser::reduce::Sum>();
+    parser.AddIntArgument('m', "max").Reduce<int, argument_parser::reduce::Max>();
+    parser.AddStringArgument("last").Reduce<std::string, argument_parser::reduce::Last>();
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -vvv --verbose -s 1 -m 7 --sum=2 -m=3 -v --last a --last=b -s 39")));
+    ASSERT_EQ(parser.GetIntValue("verbose"), 5);
+    ASSERT_EQ(verbosity, 5);
+    ASSERT_EQ(parser.GetIntValue("quiet"), 0);
+    ASSERT_EQ(parser.GetIntValue("sum"), 42);
+    ASSERT_EQ(parser.GetIntValue("max"), 7);
+    ASSERT_EQ(parser.GetStringValue("last"), "b");
+}
+
+enum class IoMode { kMmap, kPread, kUring };
+
+template<>
+struct argument_parser::ChoiceTraits<IoMode> {
+    static constexpr std::array choices = {
+        std::pair<std::string_view, IoMode>{"mmap", IoMode::kMmap},
+        std::pair<std::string_view, IoMode>{"pread", IoMode::kPread},
+        std::pair<std::string_view, IoMode>{"uring", IoMode::kUring},
+    };
+};
+
+TEST(ArgParserTestSuite, TypedValues) {
+    using argument_parser::Duration;
+    using argument_parser::ByteSize;
+    using namespace std::chrono_literals;
+
+    ArgParserLabwork parser("TestParser");
+    parser.AddArgument<Duration>('t', "timeout", "request timeout");
+    parser.AddArgument<ByteSize>("cache", "cache size");
+    parser.AddArgument<IoMode>("mode", "io mode");
+    parser.AddArgument<Duration>("interval").MultiValue<Duration>();
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -t 250ms --cache=4GiB --mode=uring --interval 1h30m --interval=1.5s")));
+    ASSERT_EQ(parser.GetValue<Duration>("timeout").value, 250ms);
+    ASSERT_EQ(parser.GetValue<ByteSize>("cache").value, 4ull << 30);
+    ASSERT_EQ(parser.GetValue<IoMode>("mode"), IoMode::kUring);
+
+    auto intervals = parser.GetValues<Duration>("interval");
+    ASSERT_EQ(intervals.size(), 2);
+    ASSERT_EQ(intervals[0].value, 90min);
+    ASSERT_EQ(intervals[1].value, 1500ms);
+
+    ASSERT_NE(parser.HelpDescription().find("mmap|pread|uring"), std::string::npos);
+
+    ArgParserLabwork wrong_parser("TestParser");
+    wrong_parser.AddArgument<IoMode>("mode");
+    wrong_parser.AddArgument<ByteSize>("cache").Default(ByteSize{1});
+    ASSERT_FALSE(wrong_parser.Parse(SplitString("app --mode=aio")));
+
+    ArgParserLabwork overflow_parser("TestParser");
+    overflow_parser.AddArgument<ByteSize>("cache");
+    ASSERT_FALSE(overflow_parser.Parse(SplitString("app --cache=100000000PiB")));
+}
+
+TEST(ArgParserTestSuite, MapArgument) {
+    std::vector<std::string> argv = SplitString("app KEY=VAL --define b=2 -D=a=x=y --define c= -D b=3 --env=HOME=/root");
+
+    ArgParserLabwork parser("TestParser");
+    parser.AddStringArgument('D', "define").Map();
+    parser.AddStringArgument("env").Map<std::string_view, std::string_view>(1);
+    parser.AddStringArgument("positional").Positional();
+
+    ASSERT_TRUE(parser.Parse(argv));
+    ASSERT_EQ(parser.GetStringValue("positional"), "KEY=VAL");
+
+    auto defines = parser.GetMap("define");
+    ASSERT_EQ(defines.size(), 3);
+    ASSERT_EQ(defines.at(std::string_view("a")), "x=y");
+    ASSERT_EQ(defines.at("b"), "3");
+    ASSERT_EQ(defines.at("c"), "");
+    ASSERT_FALSE(defines.contains("d"));
+    ASSERT_EQ(defines.begin()->first, "a");
+
+    auto env = parser.GetMap<std::string_view, std::string_view>("env");
+    ASSERT_EQ(env.at("HOME"), "/root");
+    ASSERT_EQ(env.at("HOME").data(), argv[9].data() + std::string_view("--env=HOME=").size());
+}
+
+TEST(ArgParserTestSuite, CommaSeparatedList) {
+    std::string ids_list;
+    std::vector<int> correct_ids;
+    for (int id = -20; id < 1000; id += 7) {
+        ids_list += (ids_list.empty() ? "" : ",") + std::to_string(id * 12345);
+        correct_ids.push_back(id * 12345);
+    }
+
+    ArgParserLabwork parser("TestParser");
+    std::vector<int> ids;
+    parser.AddIntArgument("ids").MultiValue<int>(3).StoreValues(ids);
+    parser.AddArgument<double>("weights").MultiValue<double>();
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --ids=" + ids_list + " --ids 7 --weights=0.5,1e3")));
+    correct_ids.push_back(7);
+    ASSERT_EQ(ids, correct_ids);
+    ASSERT_EQ(parser.GetValues<double>("weights"), (std::vector<double>{0.5, 1000}));
+
+    ArgParserLabwork wrong_parser("TestParser");
+    wrong_parser.AddIntArgument("ids").MultiValue<int>();
+    ASSERT_FALSE(wrong_parser.Parse(SplitString("app --ids=1,2,,3")));
+    ASSERT_FALSE(wrong_parser.Parse(SplitString("app --ids=1,99999999999999999999")));
+    ASSERT_FALSE(wrong_parser.Parse(SplitString("app --ids=30ka")));
+    ASSERT_FALSE(wrong_parser.Parse(SplitString("app --ids=+-3")));
+
+    // explicit plus is taken as by operator>>
+    ASSERT_TRUE(parser.Parse(SplitString("app --ids=+5,-6 --ids +7 --weights=+0.5")));
+    ASSERT_EQ(ids, (std::vector<int>{5, -6, 7}));
+    ASSERT_EQ(parser.GetValues<double>("weights"), (std::vector<double>{0.5}));
+    argument_parser::Store<unsigned> num_store;
+    ASSERT_TRUE(num_store.string_to_data("+5"));
+    ASSERT_EQ(num_store.data_, 5);
+}
+
+TEST(ArgParserTestSuite, LargePositionalList) {
+    constexpr int kValuesCount = 100000;
+    constexpr int kWrongInd = 70000;
+
+    std::vector<std::string> argv = {"app"};
+    std::vector<int> correct_values;
+    for (int value = 0; value < kValuesCount; ++value) {
+        if (value == kWrongInd) {
+            argv.push_back("wrong");
+        }
+        argv.push_back(std::to_string(value * 3));
+        if (value < kWrongInd) {
+            correct_values.push_back(value * 3);
+        }
+    }
+
+    ArgParserLabwork parser("TestParser");
+    parser.SetParallelThreshold(1024);
+    std::vector<int> values;
+    std::vector<std::string> tail;
+    parser.AddIntArgument("values").MultiValue<int>().Positional().StoreValues(values);
+    parser.AddStringArgument("tail").MultiValue<std::string>().Positional().StoreValues(tail);
+
+    ASSERT_TRUE(parser.Parse(argv));
+    ASSERT_EQ(values, correct_values);
+    ASSERT_EQ(tail.size(), kValuesCount - kWrongInd + 1);
+    ASSERT_EQ(tail.front(), "wrong");
+    ASSERT_EQ(tail.back(), std::to_string((kValuesCount - 1) * 3));
+}
+
+TEST(ArgParserTestSuite, CommandLineTokenizer) {
+    std::string_view command_line = "app  --name='John Smith' -v\t--path=/tmp/a\\ b \"q\\\"x\" '' --list=1,2";
+
+    argument_parser::TokenizerDevice tokenizer;
+    tokenizer.Run(command_line);
+    auto& tokens = tokenizer.GetTokens();
+    ASSERT_EQ(tokens, (std::vector<std::string_view>{
+        "app", "--name=John Smith", "-v", "--path=/tmp/a b", "q\"x", "", "--list=1,2"}));
+
+    auto is_inside = [&command_line](std::string_view token) {
+        return token.data() >= command_line.data() && token.data() < command_line.data() + command_line.size();
+    };
+    ASSERT_TRUE(is_inside(tokens[0]));
+    ASSERT_TRUE(is_inside(tokens[2]));
+    ASSERT_TRUE(is_inside(tokens[6]));
+    ASSERT_FALSE(is_inside(tokens[1]));
+
+    ASSERT_THROW(tokenizer.Run("app --name='John"), std::runtime_error);
+    ASSERT_THROW(tokenizer.Run("app \"John\\\""), std::runtime_error);
+    // trailing backslash is kept unquoted and unterminated in quotes
+    tokenizer.Run("app foo\\");
+    ASSERT_EQ(tokenizer.GetTokens(), (std::vector<std::string_view>{"app", "foo\\"}));
+    tokenizer.Run("app \\");
+    ASSERT_EQ(tokenizer.GetTokens(), (std::vector<std::string_view>{"app", "\\"}));
+    ASSERT_THROW(tokenizer.Run("app \"foo\\"), std::runtime_error);
+    ASSERT_THROW(tokenizer.Run("app 'foo\\"), std::runtime_error);
+
+    ArgParserLabwork parser("TestParser");
+    parser.AddStringArgument("name");
+    parser.AddFlag('v', "verbose");
+    parser.AddIntArgument("list").MultiValue<int>();
+    parser.AddStringArgument("words").MultiValue<std::string>().Positional();
+
+    ASSERT_TRUE(parser.ParseCommandLine("app --name \"John \\\"J\\\" Smith\" -v 'a b' c --list=3,4"));
+    ASSERT_EQ(parser.GetStringValue("name"), "John \"J\" Smith");
+    ASSERT_TRUE(parser.GetFlag("verbose"));
+    ASSERT_EQ(parser.GetIntValues("list"), (std::vector<int>{3, 4}));
+    ASSERT_EQ(parser.GetStringValues("words"), (std::vector<std::string>{"a b", "c"}));
+    ASSERT_FALSE(parser.ParseCommandLine("app --name 'John"));
+    ASSERT_TRUE(parser.ParseCommandLine("app w --list=1 --name foo\\"));
+    ASSERT_EQ(parser.GetStringValue("name"), "foo\\");
+    ASSERT_FALSE(parser.ParseCommandLine("app --name \"foo\\"));
+    // braced argv is not taken for a command line
+    ASSERT_TRUE(parser.Parse({"app", "x", "--list=2", "--name=n"}));
+    ASSERT_EQ(parser.GetIntValues("list"), (std::vector<int>{2}));
+}
+
+TEST(ArgParserTestSuite, ParseAnyRange) {
+    auto make_parser = []() {
+        argument_parser::ArgParser parser;
+        argument_parser::Argument count("count");
+        count.SetStore(new argument_parser::Store<int>{});
+        argument_parser::Argument name("name");
+        name.SetStore(new argument_parser::Store<std::string>{});
+        parser.registrate(std::move(count), std::move(name));
+        return parser;
+    };
+
+    char argv_data[][16] = {"--count=5", "--name", "file", "--", "-x", "y"};
+    std::vector<char*> argv = {argv_data[0], argv_data[1], argv_data[2], argv_data[3], argv_data[4], argv_data[5]};
+    auto span_parser = make_parser();
+    ASSERT_TRUE(span_parser.parse(std::span<char*>(argv)));
+    ASSERT_EQ(span_parser.GetValue<int>("count"), 5);
+    ASSERT_EQ(span_parser.GetValue<std::string>("name"), "file");
+    ASSERT_EQ(span_parser.GetPassThrough().size(), 2);
+    ASSERT_EQ(span_parser.GetPassThrough()[0], "-x");
+
+    std::list<std::string> list_argv = {"--name=list", "--count", "7", "--", "tail"};
+    auto list_parser = make_parser();
+    ASSERT_TRUE(list_parser.parse(list_argv));
+    ASSERT_EQ(list_parser.GetValue<int>("count"), 7);
+    ASSERT_EQ(list_parser.GetValue<std::string>("name"), "list");
+    ASSERT_EQ(list_parser.GetPassThrough().size(), 1);
+    ASSERT_EQ(list_parser.GetPassThrough()[0].data(), list_argv.back().data());
+
+    static constexpr std::string_view kGenerated[] = {"--count", "9", "--name", "lazy"};
+    auto lazy_parser = make_parser();
+    ASSERT_TRUE(lazy_parser.parse(std::views::iota(0, 4) |
+        std::views::transform([](int ind) { return kGenerated[ind]; })));
+    ASSERT_EQ(lazy_parser.GetValue<int>("count"), 9);
+    ASSERT_EQ(lazy_parser.GetValue<std::string>("name"), "lazy");
+}
+
+TEST(ArgParserTestSuite, TypedHandles) {
+    ArgParserLabwork parser("TestParser");
+    argument_parser::ArgHandle<int> count = parser.AddIntArgument('c', "count");
+    argument_parser::ArgHandle<std::string> name = parser.AddStringArgument("name").Default(std::string("none"));
+    argument_parser::ArgHandle<bool> verbose = parser.AddFlag('v', "verbose");
+    argument_parser::ArgHandle<std::vector<int>> ids = parser.AddIntArgument("ids").MultiValue<int>();
+    argument_parser::ArgHandle<std::string> wrong_type = parser.AddIntArgument("other");
+
+    ASSERT_FALSE(wrong_type.IsValid());
+    ASSERT_EQ(parser.GetIntValue(count), 0);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -c 3 -v --ids=1,2 --other 1")));
+    ASSERT_EQ(parser.GetIntValue(count), 3);
+    ASSERT_EQ(parser.GetStringValue(name), "none");
+    ASSERT_TRUE(parser.GetFlag(verbose));
+    ASSERT_EQ(parser.GetValue(ids), (std::vector<int>{1, 2}));
+    ASSERT_EQ(parser.GetStringValue(wrong_type), "");
+    ASSERT_EQ(parser.GetIntValue(count), parser.GetIntValue("count"));
+}
+
+namespace {
+
+struct BindingOptions {
+    int sum = 0;
+    std::string name = "none";
+    bool verbose = false;
+    argument_parser::Duration timeout{std::chrono::seconds{5}};
+    std::vector<int> ids;
+    std::vector<std::string> files;
+};
+
+constexpr auto kOptionsBinding = argument_parser::MakeBinding(
+    argument_parser::Bind('s', "sum", &BindingOptions::sum).Required(),
+    argument_parser::Bind('n', "name", &BindingOptions::name),
+    argument_parser::Bind('v', "verbose", &BindingOptions::verbose),
+    argument_parser::Bind("timeout", &BindingOptions::timeout),
+    argument_parser::Bind("ids", &BindingOptions::ids),
+    argument_parser::Bind("files", &BindingOptions::files).Positional());
+
+} // namespace
+
+TEST(ArgParserTestSuite, StructBinding) {
+    BindingOptions options;
+    std::vector<std::string> argv = {"--sum=4", "-vn", "John", "--ids", "1,2", "--ids=3", "a.txt", "--", "-b.txt"};
+    ASSERT_TRUE(kOptionsBinding.Parse(argv, options));
+    ASSERT_EQ(options.sum, 4);
+    ASSERT_EQ(options.name, "John");
+    ASSERT_TRUE(options.verbose);
+    ASSERT_EQ(options.timeout.value, std::chrono::seconds{5});
+    ASSERT_EQ(options.ids, (std::vector<int>{1, 2, 3}));
+    ASSERT_EQ(options.files, (std::vector<std::string>{"a.txt", "-b.txt"}));
+
+    BindingOptions short_options;
+    ASSERT_TRUE(kOptionsBinding.Parse(std::vector<std::string_view>{"-s7", "--timeout", "250ms"}, short_options));
+    ASSERT_EQ(short_options.sum, 7);
+    ASSERT_EQ(short_options.timeout.value, std::chrono::milliseconds{250});
+    ASSERT_EQ(short_options.name, "none");
+
+    BindingOptions wrong_options;
+    ASSERT_FALSE(kOptionsBinding.Parse(std::vector<std::string_view>{"--name", "x"}, wrong_options));
+    ASSERT_FALSE(kOptionsBinding.Parse(std::vector<std::string_view>{"--sum=x"}, wrong_options));
+    ASSERT_FALSE(kOptionsBinding.Parse(std::vector<std::string_view>{"--sum=1", "--other"}, wrong_options));
+    ASSERT_FALSE(kOptionsBinding.Parse(std::vector<std::string_view>{"--sum"}, wrong_options));
+    ASSERT_FALSE(kOptionsBinding.Parse(std::vector<std::string_view>{"--sum=1", "--verbose=1"}, wrong_options));
+}
+
+TEST(ArgParserTestSuite, ReparseAndReset) {
+    ArgParserLabwork parser("TestParser");
+    argument_parser::ArgHandle<int> level = parser.AddIntArgument("level").Default(3);
+    argument_parser::ArgHandle<std::string> name = parser.AddStringArgument("name");
+    argument_parser::ArgHandle<bool> verbose = parser.AddFlag('v', "verbose");
+    argument_parser::ArgHandle<int> count = parser.AddArgument<int>('c', "count").Counter();
+    argument_parser::ArgHandle<std::vector<int>> ids = parser.AddIntArgument("ids").MultiValue<int>(1);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --level=7 --name=first -v -cc --ids=1,2")));
+    ASSERT_EQ(parser.GetIntValue(level), 7);
+    ASSERT_EQ(parser.GetStringValue(name), "first");
+    ASSERT_TRUE(parser.GetFlag(verbose));
+    ASSERT_EQ(parser.GetValue(count), 2);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --name=second -c --ids 3")));
+    ASSERT_EQ(parser.GetIntValue(level), 3);
+    ASSERT_EQ(parser.GetStringValue(name), "second");
+    ASSERT_FALSE(parser.GetFlag(verbose));
+    ASSERT_EQ(parser.GetValue(count), 1);
+    ASSERT_EQ(parser.GetValue(ids), (std::vector<int>{3}));
+
+    parser.Reset();
+    ASSERT_EQ(parser.GetIntValue(level), 3);
+    ASSERT_EQ(parser.GetStringValue(name), "");
+    ASSERT_EQ(parser.GetValue(count), 0);
+    ASSERT_TRUE(parser.GetValue(ids).empty());
+    ASSERT_EQ(parser.GetIntValue("level"), 3);
+
+    ASSERT_FALSE(parser.Parse(SplitString("app --name=third")));
+    ASSERT_TRUE(parser.Parse(SplitString("app --name=third --level 1 --ids 4")));
+    ASSERT_EQ(parser.GetIntValue("level"), 1);
+}
+
+TEST(ArgParserTestSuite, NameTrieLookup) {
+    argument_parser::NameTrie trie;
+    trie.Build({{"verbose", 0}, {"version", 1}, {"verb", 2}, {"output", 3}, {"output-dir", 4}});
+    ASSERT_EQ(trie.Find("version"), 1);
+    ASSERT_EQ(trie.Find("vers"), argument_parser::NameTrie::kNotFound);
+    ASSERT_EQ(trie.FindPrefix("verbo"), 0);
+    ASSERT_EQ(trie.FindPrefix("verb"), 2);
+    ASSERT_EQ(trie.FindPrefix("ver"), argument_parser::NameTrie::kAmbiguous);
+    ASSERT_EQ(trie.FindPrefix("output-"), 4);
+    ASSERT_EQ(trie.FindPrefix("x"), argument_parser::NameTrie::kNotFound);
+
+    std::vector<argument_parser::NameTrie::SlotType> slots;
+    trie.Complete("ver", slots);
+    ASSERT_EQ(slots, (std::vector<argument_parser::NameTrie::SlotType>{2, 0, 1}));
+
+    ArgParserLabwork parser("TestParser");
+    std::vector<std::string> names;
+    for (int ind = 0; ind < 1000; ++ind) {
+        names.push_back("option-" + std::to_string(ind));
+    }
+    for (auto&& name : names) {
+        parser.AddIntArgument(name).Default(0);
+    }
+    parser.AddFlag("verbose");
+    parser.AddFlag("version");
+    parser.SetAbbreviation(true);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --option-999=5 --option-12 7 --verb")));
+    ASSERT_EQ(parser.GetIntValue("option-999"), 5);
+    ASSERT_EQ(parser.GetIntValue("option-12"), 7);
+    ASSERT_TRUE(parser.GetFlag("verbose"));
+    ASSERT_FALSE(parser.GetFlag("version"));
+    ASSERT_FALSE(parser.Parse(SplitString("app --ver")));
+    ASSERT_EQ(parser.Complete("option-99"), (std::vector<std::string_view>{"option-99", "option-990",
+        "option-991", "option-992", "option-993", "option-994", "option-995", "option-996", "option-997",
+        "option-998", "option-999"}));
+
+    parser.SetAbbreviation(false);
+    ASSERT_FALSE(parser.Parse(SplitString("app --verb")));
+}
+
+TEST(ArgParserTestSuite, LazySubcommands) {
+    static int built_count = 0;
+    built_count = 0;
+
+    argument_parser::ArgParser parser;
+    argument_parser::Argument verbose("verbose", "v", "");
+    verbose.SetStore(new argument_parser::Store<bool>{});
+    argument_parser::Argument level("level", "l", "");
+    level.SetStore(new argument_parser::Store<int>{});
+    parser.registrate(std::move(verbose), std::move(level));
+
+    for (int ind = 0; ind < 200; ++ind) {
+        static std::vector<std::string> names(200);
+        names[ind] = "tool" + std::to_string(ind);
+        parser.AddSubcommand(names[ind], [](argument_parser::ArgParser& subcommand_parser) {
+            ++built_count;
+            argument_parser::Argument jobs("jobs", "j", "");
+            jobs.SetStore(new argument_parser::Store<int>{});
+            argument_parser::Argument files("files");
+            files.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<std::string>>{}).Positional();
+            subcommand_parser.registrate(std::move(jobs), std::move(files));
+        });
+    }
+    ASSERT_EQ(built_count, 0);
+
+    std::vector<std::string_view> argv = {"-v", "--level", "2", "tool42", "-j", "4", "a.txt", "b.txt"};
+    ASSERT_TRUE(parser.parse(argv));
+    ASSERT_EQ(built_count, 1);
+    ASSERT_EQ(parser.GetSubcommand(), "tool42");
+    ASSERT_TRUE(parser.GetValue<bool>("verbose"));
+    ASSERT_EQ(parser.GetValue<int>("level"), 2);
+    auto* subcommand_parser = parser.GetSubcommandParser();
+    ASSERT_NE(subcommand_parser, nullptr);
+    ASSERT_EQ(subcommand_parser->GetValue<int>("jobs"), 4);
+    ASSERT_EQ(subcommand_parser->GetMultiValue<std::vector<std::string>>("files"),
+        (std::vector<std::string>{"a.txt", "b.txt"}));
+
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--level=3", "tool42", "-j", "1", "c.txt"}));
+    ASSERT_EQ(built_count, 1);
+    ASSERT_EQ(parser.GetSubcommandParser()->GetValue<int>("jobs"), 1);
+
+    ASSERT_FALSE(parser.parse(std::vector<std::string_view>{"--level=3", "unknown"}));
+    ASSERT_FALSE(parser.parse(std::vector<std::string_view>{"tool1", "--level", "1"}));
+    ASSERT_EQ(built_count, 2);
+
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--level=5"}));
+    ASSERT_EQ(parser.GetSubcommand(), "");
+    ASSERT_EQ(parser.GetSubcommandParser(), nullptr);
+
+    // values before the subcommand are owned as the lexer owns them
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"-vl", "2", "tool42", "-j", "3", "a.txt"}));
+    ASSERT_EQ(parser.GetSubcommand(), "tool42");
+    ASSERT_EQ(parser.GetValue<int>("level"), 2);
+    parser.SetStrict(false);
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--mode=fast", "--fast", "-l", "4", "tool42", "-j", "5", "a.txt"}));
+    ASSERT_EQ(parser.GetSubcommand(), "tool42");
+    ASSERT_EQ(parser.GetUnknown(), (std::vector<std::string_view>{"--mode=fast", "--fast"}));
+    ASSERT_EQ(parser.GetSubcommandParser()->GetValue<int>("jobs"), 5);
+}
+
+TEST(ArgParserTestSuite, EnvironmentFallback) {
+    ArgParserLabwork parser("My Parser");
+    parser.AddIntArgument("jobs").Environment("APP_JOBS");
+    parser.AddStringArgument("host").Environment("APP_HOST").Default(std::string("localhost"));
+    parser.AddStringArgument("mode").Default(std::string("fast"));
+    parser.AddFlag("color").Environment("APP_COLOR");
+
+    char jobs[] = "APP_JOBS=8";
+    char host[] = "APP_HOST=example.org";
+    char shadowed[] = "APP_HOST=ignored";
+    char color[] = "APP_COLOR=1";
+    char mode[] = "mode=slow";
+    char* environment[] = {jobs, host, shadowed, color, mode, nullptr};
+    parser.SetEnvironmentSource(environment);
+
+    // required argument is satisfied by environment, environment overrides default
+    ASSERT_TRUE(parser.Parse(SplitString("app")));
+    ASSERT_EQ(parser.GetIntValue("jobs"), 8);
+    ASSERT_EQ(parser.GetStringValue("host"), "example.org");
+    ASSERT_EQ(parser.GetStringValue("mode"), "fast");
+    ASSERT_TRUE(parser.GetFlag("color"));
+
+    // command line overrides environment
+    ASSERT_TRUE(parser.Parse(SplitString("app --jobs=2 --host other")));
+    ASSERT_EQ(parser.GetIntValue("jobs"), 2);
+    ASSERT_EQ(parser.GetStringValue("host"), "other");
+
+    char bad_jobs[] = "APP_JOBS=many";
+    char* bad_environment[] = {bad_jobs, nullptr};
+    parser.SetEnvironmentSource(bad_environment);
+    ASSERT_FALSE(parser.Parse(SplitString("app")));
+    ASSERT_TRUE(parser.Parse(SplitString("app --jobs 3")));
+    ASSERT_EQ(parser.GetStringValue("host"), "localhost");
+    ASSERT_FALSE(parser.GetFlag("color"));
+
+    char* empty_environment[] = {nullptr};
+    parser.SetEnvironmentSource(empty_environment);
+    ASSERT_FALSE(parser.Parse(SplitString("app")));
+}
+
+TEST(ArgParserTestSuite, ConfigFileSource) {
+    ArgParserLabwork parser("My Parser");
+    parser.AddIntArgument("jobs");
+    parser.AddStringArgument("host").Environment("APP_HOST");
+    parser.AddStringArgument("server.name").Default(std::string("none"));
+    parser.AddIntArgument("include").MultiValue<int>(1);
+    parser.AddFlag("verbose");
+
+    char host[] = "APP_HOST=from-env";
+    char* environment[] = {nullptr, nullptr};
+    parser.SetEnvironmentSource(environment);
+
+    std::string path = testing::TempDir() + "argparser_config.ini";
+    {
+        std::ofstream file(path);
+        file << "# comment\n"
+             << "jobs = 4\r\n"
+             << "host = \"from config\"\n"
+             << "include = 1\n"
+             << "\n"
+             << "; other comment\n"
+             << "[server]\n"
+             << "  name =  main \n"
+             << "[]\n"
+             << "include = 2\n"
+             << "verbose";
+    }
+    ASSERT_TRUE(parser.LoadConfig(path));
+
+    ASSERT_TRUE(parser.Parse(SplitString("app")));
+    ASSERT_EQ(parser.GetIntValue("jobs"), 4);
+    ASSERT_EQ(parser.GetStringValue("host"), "from config");
+    ASSERT_EQ(parser.GetStringValue("server.name"), "main");
+    ASSERT_EQ(parser.GetIntValues("include"), (std::vector<int>{1, 2}));
+    ASSERT_TRUE(parser.GetFlag("verbose"));
+
+    // command line and environment override config file
+    environment[0] = host;
+    ASSERT_TRUE(parser.Parse(SplitString("app --jobs 8 --include 5")));
+    ASSERT_EQ(parser.GetIntValue("jobs"), 8);
+    ASSERT_EQ(parser.GetStringValue("host"), "from-env");
+    ASSERT_EQ(parser.GetIntValues("include"), (std::vector<int>{5}));
+
+    ASSERT_FALSE(parser.SetConfig("[server\nname = x\n"));
+    ASSERT_FALSE(parser.SetConfig("jobs = 5\n[broken\n"));
+    // entries before the malformed line are dropped with the rest
+    ASSERT_FALSE(parser.Parse(SplitString("app --include 1")));
+    ASSERT_TRUE(parser.SetConfig("jobs = 1\nunknown = 2\n"));
+    ASSERT_FALSE(parser.Parse(SplitString("app --include 1")));
+    parser.SetStrict(false);
+    ASSERT_TRUE(parser.Parse(SplitString("app --include 1")));
+    ASSERT_EQ(parser.GetIntValue("jobs"), 1);
+
+    ASSERT_TRUE(parser.SetConfig("jobs = many\n"));
+    ASSERT_FALSE(parser.Parse(SplitString("app --include 1")));
+    ASSERT_FALSE(parser.LoadConfig(path + ".missing"));
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << "jobs = 5\n[broken\n";
+    }
+    ASSERT_FALSE(parser.LoadConfig(path));
+    ASSERT_FALSE(parser.Parse(SplitString("app --include 1")));
+    std::remove(path.c_str());
+}
+
+TEST(ArgParserTestSuite, ReloadSnapshots) {
+    argument_parser::ArgParser parser;
+    argument_parser::Argument low("low");
+    low.SetStore(new argument_parser::Store<int>{});
+    argument_parser::Argument high("high");
+    high.SetStore(new argument_parser::Store<int>{});
+    argument_parser::Argument name("name");
+    name.SetStore(new argument_parser::Store<std::string>{std::string("none")}).WasInitialize();
+    argument_parser::Argument jobs("jobs");
+    jobs.SetStore(new argument_parser::Store<int>{});
+    parser.registrate(std::move(low), std::move(high), std::move(name), std::move(jobs));
+    auto low_handle = parser.MakeHandle<int>(0);
+    auto high_handle = parser.MakeHandle<int>(1);
+    auto name_handle = parser.MakeHandle<std::string>(2);
+    auto jobs_handle = parser.MakeHandle<int>(3);
+
+    std::string path = testing::TempDir() + "argparser_reload.ini";
+    auto write_config = [&path](std::string_view text) {
+        std::ofstream file(path, std::ios::trunc);
+        file << text;
+    };
+    write_config("low = 1\nhigh = 1\nname = first\njobs = 7\n");
+    ASSERT_TRUE(parser.LoadConfig(path));
+    ASSERT_FALSE(parser.ReadSnapshot());
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--jobs", "2"}));
+    parser.PublishSnapshot();
+
+    // readers never see low and high of different reloads
+    std::atomic<bool> is_stopped = false;
+    std::atomic<int> torn_count = 0;
+    std::vector<std::jthread> readers;
+    for (int ind = 0; ind < 2; ++ind) {
+        readers.emplace_back([&]() {
+            while (!is_stopped) {
+                auto snapshot = parser.ReadSnapshot();
+                if (snapshot->GetValue(low_handle) != snapshot->GetValue(high_handle))
+                    ++torn_count;
+            }
+        });
+    }
+
+    const std::string* name_store = &parser.ReadSnapshot()->GetValue(name_handle);
+    int reload_count = 0;
+    for (int value = 2; value <= 50; ++value) {
+        write_config("low = " + std::to_string(value) + "\nhigh = " + std::to_string(value) +
+            "\nname = first\njobs = 7\n");
+        if (parser.Reload() && parser.GetReloaded() == std::vector<std::size_t>{0, 1})
+            ++reload_count;
+        std::this_thread::yield();
+    }
+    is_stopped = true;
+    readers.clear();
+    ASSERT_EQ(reload_count, 49);
+    ASSERT_EQ(torn_count, 0);
+
+    auto snapshot = parser.ReadSnapshot();
+    ASSERT_EQ(snapshot->GetValue(low_handle), 50);
+    ASSERT_EQ(snapshot->GetValue(jobs_handle), 2);
+    // not changed store is shared with the first snapshot
+    ASSERT_EQ(&snapshot->GetValue(name_handle), name_store);
+    ASSERT_EQ(parser.GetValue(low_handle), 50);
+    auto version = snapshot->GetVersion();
+
+    write_config("low = bad\nhigh = 1\n");
+    ASSERT_FALSE(parser.Reload());
+    write_config("high = 1\n");
+    ASSERT_FALSE(parser.Reload());
+    ASSERT_EQ(parser.ReadSnapshot()->GetVersion(), version);
+    ASSERT_EQ(parser.GetValue(low_handle), 50);
+
+    write_config("low = 3\nhigh = 3\n");
+    ASSERT_TRUE(parser.Reload());
+    ASSERT_EQ(parser.GetReloaded(), (std::vector<std::size_t>{0, 1, 2}));
+    ASSERT_EQ(parser.ReadSnapshot()->GetValue(name_handle), "none");
+
+    // removed key is reloaded after the config is resolved again, e.g. by SetStrict
+    write_config("low = 3\nhigh = 3\nname = second\n");
+    ASSERT_TRUE(parser.Reload());
+    ASSERT_EQ(parser.GetValue(name_handle), "second");
+    parser.SetStrict(true);
+    write_config("low = 3\nhigh = 3\n");
+    ASSERT_TRUE(parser.Reload());
+    ASSERT_EQ(parser.GetReloaded().back(), 2);
+    ASSERT_EQ(parser.GetValue(name_handle), "none");
+    ASSERT_EQ(parser.ReadSnapshot()->GetValue(name_handle), "none");
+    std::remove(path.c_str());
+}
+
+TEST(ArgParserTestSuite, SnapshotReadersOverSlots) {
+    argument_parser::ArgParser parser;
+    argument_parser::Argument count("count");
+    count.SetStore(new argument_parser::Store<int>{});
+    parser.registrate(std::move(count));
+    auto count_handle = parser.MakeHandle<int>(0);
+
+    // more guards than reader slots, the rest are counted and keep their snapshots
+    std::vector<argument_parser::RcuCell<argument_parser::ParseSnapshot>::ReadGuard> guards;
+    guards.reserve(100);
+    for (int value = 0; value < 100; ++value) {
+        ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--count=" + std::to_string(value)}));
+        parser.PublishSnapshot();
+        guards.push_back(parser.ReadSnapshot());
+    }
+    for (int value = 0; value < 100; ++value) {
+        ASSERT_EQ(guards[value]->GetValue(count_handle), value);
+    }
+
+    guards.clear();
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--count=100"}));
+    parser.PublishSnapshot();
+    ASSERT_EQ(parser.ReadSnapshot()->GetValue(count_handle), 100);
+}
+
+TEST(ArgParserTestSuite, ReloadBoundVariables) {
+    int low_value = 0;
+    std::vector<int> ports_value;
+    argument_parser::ArgParser parser;
+    argument_parser::Argument low("low");
+    low.SetPtrStore(&low_value);
+    argument_parser::Argument high("high");
+    high.SetStore(new argument_parser::Store<int>{});
+    argument_parser::Argument ports("ports");
+    ports.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<int>>{});
+    ports.SetPtrMultiValueStore(&ports_value);
+    parser.registrate(std::move(low), std::move(high), std::move(ports));
+
+    std::string path = testing::TempDir() + "argparser_reload_bound.ini";
+    auto write_config = [&path](std::string_view text) {
+        std::ofstream file(path, std::ios::trunc);
+        file << text;
+    };
+    write_config("low = 1\nhigh = 1\nports = 80\n");
+    ASSERT_TRUE(parser.LoadConfig(path));
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{}));
+    ASSERT_EQ(low_value, 1);
+    ASSERT_EQ(ports_value, (std::vector<int>{80}));
+
+    // validation fails without high, conversion fails on high after low and ports
+    write_config("low = 2\nports = 81\n");
+    ASSERT_FALSE(parser.Reload());
+    write_config("low = 3\nports = 82\nhigh = bad\n");
+    ASSERT_FALSE(parser.Reload());
+    ASSERT_EQ(low_value, 1);
+    ASSERT_EQ(ports_value, (std::vector<int>{80}));
+
+    write_config("low = 4\nhigh = 4\nports = 84\n");
+    ASSERT_TRUE(parser.Reload());
+    ASSERT_EQ(low_value, 4);
+    ASSERT_EQ(ports_value, (std::vector<int>{84}));
+    // the reloaded store keeps the variable for the next parse
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--low=5"}));
+    ASSERT_EQ(low_value, 5);
+    std::remove(path.c_str());
+}
+
+TEST(ArgParserTestSuite, FrozenGlobalSnapshot) {
+    argument_parser::ArgParser parser;
+    argument_parser::Argument count("count");
+    count.SetStore(new argument_parser::Store<int>{});
+    argument_parser::Argument verbose("verbose");
+    verbose.SetStore(new argument_parser::Store<bool>{});
+    argument_parser::Argument name("name");
+    name.SetStore(new argument_parser::Store<std::string>{});
+    argument_parser::Argument files("files");
+    files.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<std::string>>{}).Positional();
+    parser.registrate(std::move(count), std::move(verbose), std::move(name), std::move(files));
+    auto count_handle = parser.MakeHandle<int>(0);
+    auto verbose_handle = parser.MakeHandle<bool>(1);
+    auto name_handle = parser.MakeHandle<std::string>(2);
+    auto files_handle = parser.MakeHandle<std::vector<std::string>>(3);
+
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--count=3", "--verbose", "--name", "x", "a", "b"}));
+    auto snapshot = parser.Freeze();
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(snapshot.get()) % argument_parser::kCacheLineSize, 0);
+    argument_parser::SetGlobalSnapshot(snapshot);
+
+    // the snapshot does not follow later parses
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--count=4", "--name", "y", "c"}));
+    ASSERT_EQ(parser.GetValue(count_handle), 4);
+
+    std::atomic<int> mismatch_count = 0;
+    {
+        std::vector<std::jthread> workers;
+        for (int ind = 0; ind < 4; ++ind) {
+            workers.emplace_back([&]() {
+                const auto& options = argument_parser::GetGlobalSnapshot();
+                for (int read_ind = 0; read_ind < 1000; ++read_ind) {
+                    if (options.GetValue(count_handle) != 3 || !options.GetValue(verbose_handle) ||
+                        options.GetValue(name_handle) != "x" ||
+                        options.GetValue(files_handle) != std::vector<std::string>{"a", "b"})
+                        ++mismatch_count;
+                }
+            });
+        }
+    }
+    ASSERT_EQ(mismatch_count, 0);
+    argument_parser::SetGlobalSnapshot(nullptr);
+}
+
+TEST(ArgParserTestSuite, SchemaCacheFile) {
+    std::string path = testing::TempDir() + "argparser_schema.bin";
+    std::remove(path.c_str());
+    auto make_parser = [&path](bool is_extended) {
+        auto parser = std::make_unique<argument_parser::ArgParser>();
+        for (int ind = 0; ind < 100; ++ind) {
+            static std::vector<std::string> names(100);
+            names[ind] = "option-" + std::to_string(ind);
+            argument_parser::Argument arg(names[ind]);
+            arg.SetStore(new argument_parser::Store<int>{ind});
+            arg.WasInitialize();
+            parser->registrate(std::move(arg));
+        }
+        if (is_extended) {
+            argument_parser::Argument verbose("verbose");
+            verbose.SetStore(new argument_parser::Store<bool>{});
+            parser->registrate(std::move(verbose));
+        }
+        parser->SetSchemaCache(path);
+        parser->SetAbbreviation(true);
+        return parser;
+    };
+
+    auto first = make_parser(false);
+    ASSERT_TRUE(first->parse(std::vector<std::string_view>{"--option-42=1"}));
+    ASSERT_FALSE(first->IsSchemaCached());
+
+    // the next start maps the trie built by the first one
+    auto second = make_parser(false);
+    ASSERT_TRUE(second->parse(std::vector<std::string_view>{"--option-42=7", "--option-99", "9"}));
+    ASSERT_TRUE(second->IsSchemaCached());
+    ASSERT_EQ(second->GetValue<int>("option-42"), 7);
+    ASSERT_EQ(second->GetValue<int>("option-99"), 9);
+    ASSERT_EQ(second->GetValue<int>("option-5"), 5);
+    ASSERT_FALSE(second->parse(std::vector<std::string_view>{"--option-1000=1"}));
+    ASSERT_EQ(second->Complete("option-9").size(), 11);
+
+    // other schema rebuilds the cache
+    auto extended = make_parser(true);
+    ASSERT_TRUE(extended->parse(std::vector<std::string_view>{"--verb"}));
+    ASSERT_FALSE(extended->IsSchemaCached());
+    ASSERT_TRUE(extended->GetValue<bool>("verbose"));
+    auto extended_again = make_parser(true);
+    ASSERT_TRUE(extended_again->parse(std::vector<std::string_view>{"--verbose"}));
+    ASSERT_TRUE(extended_again->IsSchemaCached());
+
+    // damaged cache is not used
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(argument_parser::SchemaCache::Header));
+        file.write("\xff\xff\xff\x7f", 4);
+    }
+    auto damaged = make_parser(true);
+    ASSERT_TRUE(damaged->parse(std::vector<std::string_view>{"--option-3=1"}));
+    ASSERT_FALSE(damaged->IsSchemaCached());
+    ASSERT_EQ(damaged->GetValue<int>("option-3"), 1);
+
+    // concurrent starts write their own temporary files and one of them is renamed last
+    std::remove(path.c_str());
+    std::vector<std::unique_ptr<argument_parser::ArgParser>> starts;
+    for (int ind = 0; ind < 8; ++ind) {
+        starts.push_back(make_parser(false));
+    }
+    std::vector<std::thread> threads;
+    for (auto&& start : starts) {
+        threads.emplace_back([&start]() {
+            start->parse(std::vector<std::string_view>{"--option-1=1"});
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    auto after_concurrent = make_parser(false);
+    ASSERT_TRUE(after_concurrent->parse(std::vector<std::string_view>{"--option-2=3"}));
+    ASSERT_TRUE(after_concurrent->IsSchemaCached());
+    ASSERT_EQ(after_concurrent->GetValue<int>("option-2"), 3);
+    std::remove(path.c_str());
+}
+
+TEST(ArgParserTestSuite, SerializedResult) {
+    auto make_parser = []() {
+        auto parser = std::make_unique<argument_parser::ArgParser>();
+        argument_parser::Argument count("count");
+        count.SetStore(new argument_parser::Store<int>{});
+        argument_parser::Argument ratio("ratio");
+        ratio.SetStore(new argument_parser::Store<double>{0.5}).WasInitialize();
+        argument_parser::Argument name("name");
+        name.SetStore(new argument_parser::Store<std::string>{});
+        argument_parser::Argument verbose("verbose");
+        verbose.SetStore(new argument_parser::Store<bool>{});
+        argument_parser::Argument ports("ports");
+        ports.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<int>>{});
+        argument_parser::Argument files("files");
+        files.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<std::string>>{}).Positional();
+        argument_parser::Argument host("host");
+        host.SetStore(new argument_parser::Store<std::string_view>{});
+        argument_parser::Argument tags("tags");
+        tags.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<std::string_view>>{});
+        parser->registrate(std::move(count), std::move(ratio), std::move(name), std::move(verbose),
+            std::move(ports), std::move(files), std::move(host), std::move(tags));
+        return parser;
+    };
+
+    auto master = make_parser();
+    ASSERT_TRUE(master->parse(std::vector<std::string_view>{
+        "a.txt", "bb.txt", "--count=3", "--name", "worker", "--verbose", "--ports=80", "--ports=443",
+        "--host=example.org", "--tags", "fast", "safe"}));
+    std::vector<char> buffer = master->SerializeResult();
+
+    // worker registrates the same schema and reads the buffer in place
+    auto worker = make_parser();
+    argument_parser::ResultView view;
+    ASSERT_TRUE(view.Load(buffer, worker->GetSchemaHash()));
+    ASSERT_EQ(view.GetValue(worker->MakeHandle<int>(0)), 3);
+    ASSERT_EQ(view.GetValue(worker->MakeHandle<double>(1)), 0.5);
+    ASSERT_EQ(view.GetSource(1), argument_parser::Argument::DEFAULT);
+    ASSERT_EQ(view.GetValue(worker->MakeHandle<std::string>(2)), "worker");
+    ASSERT_EQ(view.GetSource(2), argument_parser::Argument::COMMAND_LINE);
+    ASSERT_TRUE(view.GetValue(worker->MakeHandle<bool>(3)));
+    auto ports = view.GetValue(worker->MakeHandle<std::vector<int>>(4));
+    ASSERT_EQ(std::vector<int>(ports.begin(), ports.end()), (std::vector<int>{80, 443}));
+    auto files = view.GetValue(worker->MakeHandle<std::vector<std::string>>(5));
+    ASSERT_EQ(files.size(), 2);
+    ASSERT_EQ(files[0], "a.txt");
+    ASSERT_EQ(files[1], "bb.txt");
+    ASSERT_EQ(view.GetStatus(5), argument_parser::Argument::WAS_INITIALIZE);
+    // views are serialized as their symbols, not as pointers into the master
+    ASSERT_EQ(view.GetValue(worker->MakeHandle<std::string_view>(6)), "example.org");
+    auto tags = view.GetValue(worker->MakeHandle<std::vector<std::string_view>>(7));
+    ASSERT_EQ(tags.size(), 2);
+    ASSERT_EQ(tags[0], "fast");
+    ASSERT_EQ(tags[1], "safe");
+    // other value type is empty, also of the same size
+    ASSERT_EQ(view.GetValue(argument_parser::ArgHandle<long long>(0)), 0);
+    ASSERT_EQ(view.GetValue(argument_parser::ArgHandle<float>(0)), 0);
+    ASSERT_TRUE(view.GetValue(argument_parser::ArgHandle<std::vector<unsigned>>(4)).empty());
+
+    argument_parser::Argument extra("extra");
+    extra.SetStore(new argument_parser::Store<int>{});
+    worker->registrate(std::move(extra));
+    ASSERT_FALSE(view.Load(buffer, worker->GetSchemaHash()));
+
+    auto damaged = buffer;
+    damaged[sizeof(argument_parser::result::Header) + 8] = 0x7f;
+    ASSERT_FALSE(view.Load(damaged, master->GetSchemaHash()));
+    ASSERT_FALSE(view.Load(std::span<const char>(buffer).first(buffer.size() - 8), master->GetSchemaHash()));
+}
+
+TEST(ArgParserTestSuite, HelpLayout) {
+    argument_parser::ArgParser parser;
+    argument_parser::Argument count("count", "c", "number of workers started for the whole run");
+    count.SetStore(new argument_parser::Store<unsigned long>{});
+    argument_parser::Argument verbose("verbose", "v", "verbose output");
+    verbose.SetStore(new argument_parser::Store<bool>{});
+    argument_parser::Argument files("files", "input files");
+    files.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<std::string>>{}).Positional();
+    argument_parser::Argument ratio("a-very-long-option-name-for-ratio", "share of work");
+    ratio.SetStore(new argument_parser::Store<double>{});
+    parser.registrate(std::move(count), std::move(verbose), std::move(files), std::move(ratio));
+    parser.SetHelpWidth(48);
+
+    std::string expected =
+        "  -c, --count <unsigned long>  number of workers\n"
+        "                               started for the\n"
+        "                               whole run\n"
+        "  -v, --verbose                verbose output\n"
+        "  files <string>...            input files\n"
+        "      --a-very-long-option-name-for-ratio <double>\n"
+        "                               share of work\n";
+    ASSERT_EQ(parser.GetDescriptions(), expected);
+
+    std::ostringstream stream;
+    parser.WriteHelp(stream);
+    ASSERT_EQ(stream.str(), expected);
+
+    std::vector<char> buffer(expected.size() - 1);
+    ASSERT_EQ(parser.WriteHelp(buffer), expected.size());
+    buffer.resize(expected.size());
+    ASSERT_EQ(parser.WriteHelp(buffer), expected.size());
+    ASSERT_EQ(std::string_view(buffer.data(), buffer.size()), expected);
+
+    // layout is rebuilt after registration
+    argument_parser::Argument port("port", "listen port");
+    port.SetStore(new argument_parser::Store<int>{});
+    parser.registrate(std::move(port));
+    ASSERT_NE(parser.GetDescriptions().find("      --port <int>"), std::string::npos);
+}
+
+TEST(ArgParserTestSuite, DuplicateNameOfOtherType) {
+    argument_parser::ArgParser parser;
+    argument_parser::Argument count("count");
+    count.SetStore(new argument_parser::Store<int>{});
+    argument_parser::Argument same_count("count");
+    same_count.SetStore(new argument_parser::Store<int>{});
+    argument_parser::Argument other_count("count");
+    other_count.SetStore(new argument_parser::Store<std::string>{});
+    ASSERT_EQ(parser.registrate_slot(std::move(count)), 0);
+    ASSERT_EQ(parser.registrate_slot(std::move(same_count)), 0);
+    ASSERT_EQ(parser.registrate_slot(std::move(other_count)), argument_parser::ArgParser::kNoSlot);
+
+    // handle of the rejected argument reads nothing, the first one keeps the value
+    ArgParserLabwork labwork("TestParser");
+    argument_parser::ArgHandle<int> int_count = labwork.AddIntArgument("count");
+    argument_parser::ArgHandle<std::string> string_count = labwork.AddStringArgument("count");
+    ASSERT_TRUE(int_count.IsValid());
+    ASSERT_TRUE(string_count.IsValid());
+    ASSERT_TRUE(labwork.Parse(SplitString("app --count=5")));
+    ASSERT_EQ(labwork.GetValue(int_count), 5);
+    ASSERT_EQ(labwork.GetValue(string_count), "");
+}
+
+TEST(ArgParserTestSuite, HelpShortCircuit) {
+    argument_parser::ArgParser parser;
+    argument_parser::Argument count("count", "c", "");
+    count.SetStore(new argument_parser::Store<int>{});
+    argument_parser::Argument help("help", "h", "");
+    help.SetStore(new argument_parser::Store<bool>{});
+    auto help_slot = parser.registrate_slot(std::move(count));
+    help_slot = parser.registrate_slot(std::move(help));
+    parser.SetHelpSlot(help_slot);
+
+    // required count is missing and values are wrong, but nothing is converted or checked
+    std::vector<std::string_view> argv = {"--count=abc", "--unknown"};
+    for (int ind = 0; ind < 100000; ++ind) {
+        argv.push_back("not-a-number");
+    }
+    argv.insert(argv.begin() + 1, "-h");
+    ASSERT_TRUE(parser.parse(argv));
+    ASSERT_EQ(parser.GetParseStatus(), argument_parser::ParseStatus::HELP_REQUESTED);
+    ASSERT_TRUE(parser.GetValue(parser.MakeHandle<bool>(help_slot)));
+
+    ASSERT_FALSE(parser.parse(std::vector<std::string_view>{"--count=abc"}));
+    ASSERT_EQ(parser.GetParseStatus(), argument_parser::ParseStatus::FAILED);
+    ASSERT_FALSE(parser.GetValue(parser.MakeHandle<bool>(help_slot)));
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"--count=3"}));
+    ASSERT_EQ(parser.GetParseStatus(), argument_parser::ParseStatus::PARSED);
+    // tokens after "--" are not options, so help there is passed through
+    ASSERT_TRUE(parser.parse(std::vector<std::string_view>{"-c", "3", "--", "--help"}));
+    ASSERT_EQ(parser.GetParseStatus(), argument_parser::ParseStatus::PARSED);
+
+    ArgParserLabwork labwork("My Parser");
+    labwork.AddIntArgument("number");
+    labwork.AddHelp('h', "help", "Some Description about program");
+    ASSERT_TRUE(labwork.Parse(SplitString("app --number=x --help")));
+    ASSERT_EQ(labwork.GetParseStatus(), argument_parser::ParseStatus::HELP_REQUESTED);
+    ASSERT_TRUE(labwork.Help());
+}
+
+TEST(ArgParserTestSuite, CompletionEngine) {
+    using Candidates = std::vector<std::string>;
+    argument_parser::ArgParser parser;
+    argument_parser::Argument mode("mode", "m", "");
+    mode.SetStore(new argument_parser::Store<IoMode>{});
+    argument_parser::Argument modes("modes", "");
+    modes.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<IoMode>>{});
+    argument_parser::Argument verbose("verbose", "v", "");
+    verbose.SetStore(new argument_parser::Store<bool>{});
+    parser.registrate(std::move(mode), std::move(modes), std::move(verbose));
+    parser.AddSubcommand("build", [](argument_parser::ArgParser& subcommand_parser) {
+        argument_parser::Argument jobs("jobs", "j", "");
+        jobs.SetStore(new argument_parser::Store<int>{});
+        subcommand_parser.registrate(std::move(jobs));
+    });
+    parser.AddSubcommand("bench", [](argument_parser::ArgParser&) {});
+
+    auto complete = [&parser](std::string_view line) { return parser.CompleteLine(line, line.size()); };
+    ASSERT_EQ(complete("prog --mo"), (Candidates{"--mode", "--modes"}));
+    ASSERT_EQ(complete("prog --mode="), (Candidates{"--mode=mmap", "--mode=pread", "--mode=uring"}));
+    ASSERT_EQ(complete("prog --mode=p"), (Candidates{"--mode=pread"}));
+    ASSERT_EQ(complete("prog -m u"), (Candidates{"uring"}));
+    ASSERT_EQ(complete("prog --modes mmap "), (Candidates{"mmap", "pread", "uring"}));
+    ASSERT_EQ(complete("prog --verbose b"), (Candidates{"bench", "build"}));
+    ASSERT_EQ(complete("prog -"), (Candidates{"-m", "-v", "--mode", "--modes", "--verbose"}));
+    ASSERT_EQ(complete("prog -v build --j"), (Candidates{"--jobs"}));
+    ASSERT_EQ(complete("prog build -"), (Candidates{"-j", "--jobs"}));
+    // cursor inside the line, partial input with unknown options does not throw
+    ASSERT_EQ(parser.CompleteLine("prog --unknown --ve --mode", 19), (Candidates{"--verbose"}));
+    ASSERT_TRUE(complete("prog \"--mo").empty());
+    ASSERT_TRUE(complete("prog --mode=x --unknown=").empty());
+    // trailing backslash is kept as a symbol of the word
+    ASSERT_TRUE(parser.CompleteLine("prog foo\\", 9).empty());
+    ASSERT_TRUE(complete("prog --mo\\").empty());
+
+    ASSERT_NE(argument_parser::MakeCompletionScript(argument_parser::Shell::BASH, "/usr/bin/tool")
+        .find("complete -o default -F _tool_complete tool"), std::string::npos);
+    ASSERT_NE(argument_parser::MakeCompletionScript(argument_parser::Shell::ZSH, "tool")
+        .find("compdef _tool_complete tool"), std::string::npos);
+}
+
+TEST(ArgParserTestSuite, AllocationBudget) {
+    using argument_parser::allocation::Phase;
+    argument_parser::ArgParser parser;
+    argument_parser::Argument count("count", "c", "");
+    count.SetStore(new argument_parser::Store<int>{});
+    argument_parser::Argument name("name", "n", "");
+    name.SetStore(new argument_parser::Store<std::string_view>{});
+    argument_parser::Argument verbose("verbose", "v", "");
+    verbose.SetStore(new argument_parser::Store<bool>{});
+    argument_parser::Argument ratio("ratio", "");
+    ratio.SetStore(new argument_parser::Store<double>{1.0}).WasInitialize();
+    argument_parser::Argument files("files");
+    files.SetMultiValueStore(new argument_parser::MultiValueStore<std::vector<std::string_view>>{}).Positional();
+    parser.registrate(std::move(count), std::move(name), std::move(verbose), std::move(ratio), std::move(files));
+
+    std::vector<std::string_view> argv = {"a.txt", "b.txt", "c.txt", "--count=3", "-n", "worker", "-v", "--ratio", "0.5"};
+    ASSERT_TRUE(parser.parse(argv));
+
+    // budgets of the current pipeline: one shared lexeme per lexeme and a few lexeme vectors,
+    // one vector of positional values; raise them only with a reason
+    argument_parser::allocation::Recorder recorder;
+    ASSERT_TRUE(parser.parse(argv));
+    auto steady_report = recorder.Get();
+    EXPECT_LE(steady_report.Total().count, 15) << steady_report;
+    EXPECT_LE(steady_report[Phase::LEXEME].count, 14) << steady_report;
+    EXPECT_LE(steady_report[Phase::CONVERSION].count, 1) << steady_report;
+    EXPECT_EQ(steady_report[Phase::VALIDATION].count, 0) << steady_report;
+    EXPECT_EQ(steady_report[Phase::ERROR].count, 0) << steady_report;
+    EXPECT_EQ(steady_report[Phase::OTHER].count, 0) << steady_report;
+
+    // re-parse loop does not accumulate allocations
+    for (int ind = 0; ind < 100; ++ind) {
+        recorder.Restart();
+        ASSERT_TRUE(parser.parse(argv));
+        ASSERT_EQ(recorder.Get().Total().count, steady_report.Total().count);
+    }
+
+    argv.push_back("--unknown");
+    recorder.Restart();
+    ASSERT_FALSE(parser.parse(argv));
+    auto error_report = recorder.Get();
+    EXPECT_GT(error_report[Phase::ERROR].count, 0) << error_report;
+    EXPECT_LE(error_report.Total().count, 16) << error_report;
+
+    ArgParserLabwork labwork("My Parser");
+    labwork.AddIntArgument('c', "count");
+    labwork.AddStringArgument('n', "name");
+    labwork.AddFlag('v', "verbose");
+    labwork.AddIntArgument("values").MultiValue<int>(1).Positional();
+    std::string_view command_line = "app 1 2 3 4 5 6 7 8 --count 3 --name 'big worker' -v";
+    ASSERT_TRUE(labwork.ParseCommandLine(command_line));
+    recorder.Restart();
+    ASSERT_TRUE(labwork.ParseCommandLine(command_line));
+    auto labwork_report = recorder.Get();
+    // tokens and unescaped strings of the tokenizer are reused
+    EXPECT_EQ(labwork_report[Phase::TOKENIZE].count, 0) << labwork_report;
+    EXPECT_LE(labwork_report.Total().count, 17) << labwork_report;
+}